@@ -0,0 +1,428 @@
+#define         _GNU_SOURCE
+
+#include        <pthread.h>
+#include        <sched.h>
+#include        <stdatomic.h>
+#include        <stdint.h>
+#include        <stdio.h>
+#include        <stdlib.h>
+#include        <time.h>
+#include        <unistd.h>
+
+#include        "hardware/clocks.h"
+#include        "hardware/gpio.h"
+#include        "hardware/vreg.h"
+#include        "pico/host_shim.h"
+#include        "pico/multicore.h"
+#include        "pico/platform.h"
+#include        "pico/stdio_usb.h"
+#include        "pico/stdlib.h"
+#include        "pico/time.h"
+
+#define         FIFO_DEPTH          8u
+#define         GPIO_COUNT          30u
+#define         ALARM_COUNT         4u
+#define         DEFAULT_ALARM_NUM   3u
+#define         TIMER_COUNT         8u
+
+typedef struct host_fifo_s
+{
+    uint32_t data[FIFO_DEPTH];
+    size_t head;
+    size_t count;
+} host_fifo;
+
+struct alarm_pool
+{
+    uint core;
+    uint hardware_alarm_num;
+};
+
+typedef struct host_timer_s
+{
+    pthread_t thread;
+    repeating_timer_t* rt;
+    bool in_use;
+    atomic_bool cancelled;
+    atomic_bool finished;
+} host_timer;
+
+static uint64_t boot_time_us;
+static _Thread_local uint core_num;
+
+static pthread_t core1_thread;
+static void (*core1_entry)(void);
+static atomic_bool core1_running;
+
+/* fifos[n] carries words towards core n. */
+static host_fifo fifos[2u];
+static pthread_mutex_t fifo_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t fifo_changed = PTHREAD_COND_INITIALIZER;
+
+static alarm_pool_t alarm_pools[ALARM_COUNT];
+static host_timer timers[TIMER_COUNT];
+static pthread_mutex_t timer_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static uint32_t sys_clock_khz = 125000u;
+static enum vreg_voltage vreg_voltage = VREG_VOLTAGE_DEFAULT;
+static uint32_t gpio_out_mask;
+static uint32_t gpio_state;
+
+static uint64_t monotonic_us(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000u) + ((uint64_t)now.tv_nsec / 1000u);
+}
+
+/* Pins the calling thread to one host CPU per core, wrapping on small machines. */
+static void pin_to_core(uint core)
+{
+    long cpu_count = sysconf(_SC_NPROCESSORS_ONLN);
+    cpu_set_t cpus;
+
+    if(cpu_count < 1)
+    {
+        return;
+    }
+    CPU_ZERO(&cpus);
+    CPU_SET(core % (uint)cpu_count, &cpus);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+}
+
+__attribute__((constructor)) static void host_shim_init(void)
+{
+    boot_time_us = monotonic_us();
+    core_num = 0u;
+    pin_to_core(0u);
+}
+
+uint64_t time_us_64(void)
+{
+    return monotonic_us() - boot_time_us;
+}
+
+void sleep_until(absolute_time_t target)
+{
+    int64_t remaining_us = absolute_time_diff_us(get_absolute_time(), target);
+    struct timespec delay;
+
+    if(remaining_us <= 0)
+    {
+        return;
+    }
+    delay.tv_sec = remaining_us / 1000000;
+    delay.tv_nsec = (remaining_us % 1000000) * 1000;
+    while(nanosleep(&delay, &delay) != 0);
+}
+
+void sleep_us(uint64_t us)
+{
+    sleep_until(make_timeout_time_us(us));
+}
+
+void sleep_ms(uint32_t ms)
+{
+    sleep_us(1000u * (uint64_t)ms);
+}
+
+void tight_loop_contents(void)
+{
+    sched_yield();
+}
+
+uint get_core_num(void)
+{
+    return core_num;
+}
+
+bool stdio_init_all(void)
+{
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    return true;
+}
+
+bool stdio_usb_init(void)
+{
+    return stdio_init_all();
+}
+
+void gpio_init(uint gpio)
+{
+    if(gpio < GPIO_COUNT)
+    {
+        gpio_out_mask &= ~(1u << gpio);
+        gpio_state &= ~(1u << gpio);
+    }
+}
+
+void gpio_set_dir(uint gpio, bool out)
+{
+    if(gpio < GPIO_COUNT)
+    {
+        gpio_out_mask = out ? (gpio_out_mask | (1u << gpio)) : (gpio_out_mask & ~(1u << gpio));
+    }
+}
+
+void gpio_put(uint gpio, bool value)
+{
+    if(gpio < GPIO_COUNT)
+    {
+        gpio_state = value ? (gpio_state | (1u << gpio)) : (gpio_state & ~(1u << gpio));
+    }
+}
+
+bool gpio_get(uint gpio)
+{
+    return (gpio < GPIO_COUNT) && ((gpio_state >> gpio) & 1u);
+}
+
+bool set_sys_clock_khz(uint32_t freq_khz, bool required)
+{
+    (void)required;
+    sys_clock_khz = freq_khz;
+    return true;
+}
+
+uint32_t clock_get_hz(enum clock_index clk_index)
+{
+    switch(clk_index)
+    {
+        case clk_sys:
+        case clk_peri:
+            return sys_clock_khz * 1000u;
+        case clk_ref:
+            return 12000000u;
+        case clk_usb:
+        case clk_adc:
+            return 48000000u;
+        case clk_rtc:
+            return 46875u;
+        default:
+            return 0u;
+    }
+}
+
+void vreg_set_voltage(enum vreg_voltage voltage)
+{
+    vreg_voltage = voltage;
+}
+
+uint32_t host_shim_sys_clock_khz(void)
+{
+    return sys_clock_khz;
+}
+
+enum vreg_voltage host_shim_vreg_voltage(void)
+{
+    return vreg_voltage;
+}
+
+alarm_pool_t* alarm_pool_get_default(void)
+{
+    /* The SDK sets the default pool up on core 0 during runtime init. */
+    alarm_pools[DEFAULT_ALARM_NUM].core = 0u;
+    alarm_pools[DEFAULT_ALARM_NUM].hardware_alarm_num = DEFAULT_ALARM_NUM;
+    return &alarm_pools[DEFAULT_ALARM_NUM];
+}
+
+alarm_pool_t* alarm_pool_create(uint hardware_alarm_num, uint max_timers)
+{
+    alarm_pool_t* pool = &alarm_pools[hardware_alarm_num % ALARM_COUNT];
+
+    (void)max_timers;
+    pool->core = core_num;
+    pool->hardware_alarm_num = hardware_alarm_num % ALARM_COUNT;
+    return pool;
+}
+
+static void* timer_thread(void* arg)
+{
+    host_timer* timer = arg;
+    repeating_timer_t* rt = timer->rt;
+    uint64_t period_us = (rt->delay_us < 0) ? (uint64_t)(-rt->delay_us) : (uint64_t)rt->delay_us;
+    absolute_time_t target = delayed_by_us(get_absolute_time(), period_us);
+
+    core_num = rt->pool->core;
+    pin_to_core(core_num);
+    while(!atomic_load(&timer->cancelled))
+    {
+        sleep_until(target);
+        if(atomic_load(&timer->cancelled) || !rt->callback(rt))
+        {
+            break;
+        }
+        /* Like the SDK, a fixed-rate timer that overran fires again at once rather than skipping ticks. */
+        target = (rt->delay_us < 0) ? delayed_by_us(target, period_us) : make_timeout_time_us(period_us);
+    }
+    atomic_store(&timer->finished, true);
+    return NULL;
+}
+
+bool alarm_pool_add_repeating_timer_us(alarm_pool_t* pool, int64_t delay_us, repeating_timer_callback_t callback, void* user_data,
+                                       repeating_timer_t* out)
+{
+    host_timer* timer = NULL;
+
+    pthread_mutex_lock(&timer_lock);
+    for(size_t i = 0u; i < TIMER_COUNT; i++)
+    {
+        /* Timers whose callback returned false have stopped on their own and only need joining. */
+        if(timers[i].in_use && atomic_load(&timers[i].finished))
+        {
+            pthread_join(timers[i].thread, NULL);
+            timers[i].in_use = false;
+        }
+        if((timer == NULL) && !timers[i].in_use)
+        {
+            timer = &timers[i];
+            timer->in_use = true;
+        }
+    }
+    pthread_mutex_unlock(&timer_lock);
+    if((timer == NULL) || (delay_us == 0))
+    {
+        if(timer != NULL)
+        {
+            timer->in_use = false;
+        }
+        return false;
+    }
+
+    out->delay_us = delay_us;
+    out->pool = pool;
+    out->alarm_id = (alarm_id_t)(timer - timers) + 1;
+    out->callback = callback;
+    out->user_data = user_data;
+    timer->rt = out;
+    atomic_store(&timer->cancelled, false);
+    atomic_store(&timer->finished, false);
+    if(pthread_create(&timer->thread, NULL, timer_thread, timer) != 0)
+    {
+        timer->in_use = false;
+        return false;
+    }
+    return true;
+}
+
+bool cancel_repeating_timer(repeating_timer_t* timer)
+{
+    host_timer* host = NULL;
+    bool was_running;
+
+    if((timer->alarm_id < 1) || (timer->alarm_id > (alarm_id_t)TIMER_COUNT))
+    {
+        return false;
+    }
+    host = &timers[timer->alarm_id - 1];
+    pthread_mutex_lock(&timer_lock);
+    if(!host->in_use || (host->rt != timer))
+    {
+        pthread_mutex_unlock(&timer_lock);
+        return false;
+    }
+    was_running = !atomic_load(&host->finished);
+    atomic_store(&host->cancelled, true);
+    pthread_join(host->thread, NULL);
+    host->in_use = false;
+    pthread_mutex_unlock(&timer_lock);
+    timer->alarm_id = 0;
+    return was_running;
+}
+
+static void* core1_trampoline(void* unused)
+{
+    (void)unused;
+    core_num = 1u;
+    pin_to_core(1u);
+    core1_entry();
+    /* Like a core 1 whose entry returned, it is idle again and may be reset or relaunched. */
+    atomic_store(&core1_running, false);
+    return NULL;
+}
+
+void multicore_launch_core1(void (*entry)(void))
+{
+    if(atomic_load(&core1_running))
+    {
+        fprintf(stderr, "host_shim: core 1 is already running.\n");
+        abort();
+    }
+    core1_entry = entry;
+    atomic_store(&core1_running, true);
+    if(pthread_create(&core1_thread, NULL, core1_trampoline, NULL) != 0)
+    {
+        fprintf(stderr, "host_shim: could not start the core 1 thread.\n");
+        abort();
+    }
+    pthread_detach(core1_thread);
+}
+
+void multicore_reset_core1(void)
+{
+    /* A running pthread can't be reset safely, so only an idle core 1 is supported. */
+    if(atomic_load(&core1_running))
+    {
+        fprintf(stderr, "host_shim: multicore_reset_core1 on a running core 1 is not supported.\n");
+        abort();
+    }
+    multicore_fifo_drain();
+}
+
+bool multicore_fifo_rvalid(void)
+{
+    pthread_mutex_lock(&fifo_lock);
+    bool valid = fifos[core_num].count != 0u;
+    pthread_mutex_unlock(&fifo_lock);
+    return valid;
+}
+
+bool multicore_fifo_wready(void)
+{
+    pthread_mutex_lock(&fifo_lock);
+    bool ready = fifos[core_num ^ 1u].count != FIFO_DEPTH;
+    pthread_mutex_unlock(&fifo_lock);
+    return ready;
+}
+
+void multicore_fifo_push_blocking(uint32_t data)
+{
+    host_fifo* fifo = &fifos[core_num ^ 1u];
+
+    pthread_mutex_lock(&fifo_lock);
+    while(fifo->count == FIFO_DEPTH)
+    {
+        pthread_cond_wait(&fifo_changed, &fifo_lock);
+    }
+    fifo->data[(fifo->head + fifo->count) % FIFO_DEPTH] = data;
+    fifo->count = fifo->count + 1u;
+    pthread_cond_broadcast(&fifo_changed);
+    pthread_mutex_unlock(&fifo_lock);
+}
+
+uint32_t multicore_fifo_pop_blocking(void)
+{
+    host_fifo* fifo = &fifos[core_num];
+    uint32_t data;
+
+    pthread_mutex_lock(&fifo_lock);
+    while(fifo->count == 0u)
+    {
+        pthread_cond_wait(&fifo_changed, &fifo_lock);
+    }
+    data = fifo->data[fifo->head];
+    fifo->head = (fifo->head + 1u) % FIFO_DEPTH;
+    fifo->count = fifo->count - 1u;
+    pthread_cond_broadcast(&fifo_changed);
+    pthread_mutex_unlock(&fifo_lock);
+    return data;
+}
+
+void multicore_fifo_drain(void)
+{
+    pthread_mutex_lock(&fifo_lock);
+    fifos[core_num].head = 0u;
+    fifos[core_num].count = 0u;
+    pthread_cond_broadcast(&fifo_changed);
+    pthread_mutex_unlock(&fifo_lock);
+}
@@ -0,0 +1,27 @@
+#ifndef         _HARDWARE_CLOCKS_H
+#define         _HARDWARE_CLOCKS_H
+
+#include        "pico/types.h"
+
+enum clock_index
+{
+    clk_gpout0 = 0,
+    clk_gpout1,
+    clk_gpout2,
+    clk_gpout3,
+    clk_ref,
+    clk_sys,
+    clk_peri,
+    clk_usb,
+    clk_adc,
+    clk_rtc,
+    CLK_COUNT
+};
+
+/* Recorded only, read back with host_shim_sys_clock_khz(). Always succeeds. */
+bool set_sys_clock_khz(uint32_t freq_khz, bool required);
+
+/* Nominal frequency: clk_sys follows set_sys_clock_khz, the rest report the SDK defaults. */
+uint32_t clock_get_hz(enum clock_index clk_index);
+
+#endif
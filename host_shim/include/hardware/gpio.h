@@ -0,0 +1,15 @@
+#ifndef         _HARDWARE_GPIO_H
+#define         _HARDWARE_GPIO_H
+
+#include        "pico/types.h"
+
+#define         GPIO_OUT            1
+#define         GPIO_IN             0
+
+/* GPIO calls only drive the recorded pin state, there are no pins on the host. */
+void gpio_init(uint gpio);
+void gpio_set_dir(uint gpio, bool out);
+void gpio_put(uint gpio, bool value);
+bool gpio_get(uint gpio);
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef         _HARDWARE_SYNC_H
+#define         _HARDWARE_SYNC_H
+
+#include        "pico/types.h"
+
+/* The cores are threads on the host, so the barriers have to order the host's memory too, not just the compiler. */
+static inline void __dmb(void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+static inline void __mem_fence_acquire(void)
+{
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+}
+
+static inline void __mem_fence_release(void)
+{
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef         _PICO_HOST_SHIM_H
+#define         _PICO_HOST_SHIM_H
+
+#include        "hardware/vreg.h"
+#include        "pico/types.h"
+
+/* Values the firmware asked for through the no-op hardware calls. */
+uint32_t host_shim_sys_clock_khz(void);
+enum vreg_voltage host_shim_vreg_voltage(void);
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef         _PICO_MULTICORE_H
+#define         _PICO_MULTICORE_H
+
+#include        "pico/types.h"
+
+/* Core 1 is a pthread pinned next to core 0, see host_shim.c. */
+void multicore_launch_core1(void (*entry)(void));
+void multicore_reset_core1(void);
+
+/* Two 8-entry word FIFOs, one per direction, like the SIO FIFOs. */
+bool multicore_fifo_rvalid(void);
+bool multicore_fifo_wready(void);
+void multicore_fifo_push_blocking(uint32_t data);
+uint32_t multicore_fifo_pop_blocking(void);
+void multicore_fifo_drain(void);
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef         _PICO_PLATFORM_H
+#define         _PICO_PLATFORM_H
+
+#include        "pico/types.h"
+
+#define         __not_in_flash_func(func_name)      func_name
+#define         __time_critical_func(func_name)     func_name
+
+/* The host has one flat memory, so bank placement attributes are dropped. */
+#define         __scratch_x(group)
+#define         __scratch_y(group)
+
+/* Yields the host CPU, so a waiting core doesn't starve its own timer thread. */
+void tight_loop_contents(void);
+
+/* Number of the core the calling thread stands in for, 0 or 1. */
+uint get_core_num(void);
+
+#endif
@@ -0,0 +1,9 @@
+#ifndef         _PICO_STDIO_USB_H
+#define         _PICO_STDIO_USB_H
+
+#include        "pico/types.h"
+
+/* stdio already goes to the terminal, this only makes stdout line buffered. */
+bool stdio_usb_init(void);
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef         _PICO_STDLIB_H
+#define         _PICO_STDLIB_H
+
+#include        <stdio.h>
+
+#include        "hardware/clocks.h"
+#include        "hardware/gpio.h"
+#include        "pico/host_shim.h"
+#include        "pico/platform.h"
+#include        "pico/time.h"
+#include        "pico/types.h"
+
+#define         PICO_DEFAULT_LED_PIN        25
+
+bool stdio_init_all(void);
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef         _PICO_TIME_H
+#define         _PICO_TIME_H
+
+#include        "pico/types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Microseconds since the shim was loaded, read from CLOCK_MONOTONIC. */
+uint64_t time_us_64(void);
+
+static inline uint32_t time_us_32(void)
+{
+    return (uint32_t)time_us_64();
+}
+
+static inline absolute_time_t get_absolute_time(void)
+{
+    return time_us_64();
+}
+
+static inline uint64_t to_us_since_boot(absolute_time_t t)
+{
+    return t;
+}
+
+static inline uint32_t to_ms_since_boot(absolute_time_t t)
+{
+    return (uint32_t)(t / 1000u);
+}
+
+static inline int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to)
+{
+    return (int64_t)(to - from);
+}
+
+static inline absolute_time_t delayed_by_us(absolute_time_t t, uint64_t us)
+{
+    return t + us;
+}
+
+static inline absolute_time_t make_timeout_time_us(uint64_t us)
+{
+    return delayed_by_us(get_absolute_time(), us);
+}
+
+static inline absolute_time_t make_timeout_time_ms(uint32_t ms)
+{
+    return delayed_by_us(get_absolute_time(), 1000u * (uint64_t)ms);
+}
+
+void sleep_us(uint64_t us);
+void sleep_ms(uint32_t ms);
+void sleep_until(absolute_time_t target);
+
+/* Repeating timers run on a host thread pinned next to the core that owns the pool, standing in for its alarm IRQ. */
+typedef int32_t alarm_id_t;
+typedef struct alarm_pool alarm_pool_t;
+typedef struct repeating_timer repeating_timer_t;
+typedef bool (*repeating_timer_callback_t)(repeating_timer_t* rt);
+
+struct repeating_timer
+{
+    int64_t delay_us;
+    alarm_pool_t* pool;
+    alarm_id_t alarm_id;
+    repeating_timer_callback_t callback;
+    void* user_data;
+};
+
+alarm_pool_t* alarm_pool_get_default(void);
+alarm_pool_t* alarm_pool_create(uint hardware_alarm_num, uint max_timers);
+
+/* A negative delay_us keeps a fixed rate from callback start to callback start, a positive one waits after each callback ends. */
+bool alarm_pool_add_repeating_timer_us(alarm_pool_t* pool, int64_t delay_us, repeating_timer_callback_t callback, void* user_data,
+                                       repeating_timer_t* out);
+bool cancel_repeating_timer(repeating_timer_t* timer);
+
+static inline bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback, void* user_data, repeating_timer_t* out)
+{
+    return alarm_pool_add_repeating_timer_us(alarm_pool_get_default(), delay_us, callback, user_data, out);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
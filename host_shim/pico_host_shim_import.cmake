@@ -0,0 +1,24 @@
+# Stand-in for pico_sdk_import.cmake when building for the host with PICO_HOST_SHIM.
+# Like the SDK import, it should be include()ed prior to project()
+
+set(PICO_HOST_SHIM_PATH ${CMAKE_CURRENT_LIST_DIR})
+
+if (NOT CMAKE_BUILD_TYPE)
+    set(CMAKE_BUILD_TYPE Release)
+endif ()
+
+function(pico_sdk_init)
+    if (NOT TARGET pico_host_shim)
+        add_subdirectory(${PICO_HOST_SHIM_PATH} ${CMAKE_BINARY_DIR}/host_shim)
+    endif ()
+endfunction()
+
+# Board output options have no meaning on the host.
+function(pico_enable_stdio_usb TARGET ENABLED)
+endfunction()
+
+function(pico_enable_stdio_uart TARGET ENABLED)
+endfunction()
+
+function(pico_add_extra_outputs TARGET)
+endfunction()
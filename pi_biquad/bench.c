@@ -0,0 +1,43 @@
+#include        <stdint.h>
+
+#include        "pico/multicore.h"
+
+#include        "bench.h"
+
+#define         BENCH_TOKEN_JOB         0xB1C0DE01u
+#define         BENCH_TOKEN_DONE        0xB1C0DE02u
+
+bench_buffers core_buffers[2u];
+
+/* Volatile so the store can't move past the FIFO write that publishes it. */
+static bench_job volatile pending_job;
+
+void bench_core1_loop(void)
+{
+    while(1)
+    {
+        if(multicore_fifo_pop_blocking() == BENCH_TOKEN_JOB)
+        {
+            pending_job(1);
+            multicore_fifo_push_blocking(BENCH_TOKEN_DONE);
+        }
+    }
+}
+
+void bench_launch_on_core1(bench_job job)
+{
+    pending_job = job;
+    multicore_fifo_push_blocking(BENCH_TOKEN_JOB);
+}
+
+void bench_wait_core1(void)
+{
+    while(multicore_fifo_pop_blocking() != BENCH_TOKEN_DONE);
+}
+
+void bench_run_on_both_cores(bench_job job)
+{
+    bench_launch_on_core1(job);
+    job(0);
+    bench_wait_core1();
+}
@@ -0,0 +1,43 @@
+#ifndef         _BENCH_H
+#define         _BENCH_H
+
+#include        <stddef.h>
+#include        <stdint.h>
+
+#include        "pico/time.h"
+
+/* A benchmark step, called with the number of the core running it. */
+typedef void (*bench_job)(int core_number);
+
+/* Per-core sample buffers, registered by each core before it runs any job. */
+typedef struct bench_buffers_s
+{
+    int16_t* in;
+    int16_t* out;
+    size_t length;
+} bench_buffers;
+
+extern bench_buffers core_buffers[2u];
+
+/* Core 1 entry point: runs jobs handed over by core 0 through the FIFO, forever. */
+void bench_core1_loop(void);
+
+/* Starts job on core 1 and returns at once. The FIFO belongs to the job until bench_wait_core1(). */
+void bench_launch_on_core1(bench_job job);
+void bench_wait_core1(void);
+
+/* Runs the same job on both cores at the same time and returns when both are done. */
+void bench_run_on_both_cores(bench_job job);
+
+static inline uint64_t bench_elapsed_us(absolute_time_t start_time)
+{
+    int64_t duration_us = absolute_time_diff_us(start_time, get_absolute_time());
+    return (duration_us > 0) ? (uint64_t)duration_us : 1u;
+}
+
+static inline uint64_t bench_kilo_per_second(uint64_t count, uint64_t duration_us)
+{
+    return (count * 1000u) / duration_us;
+}
+
+#endif
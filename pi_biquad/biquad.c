@@ -0,0 +1,146 @@
+#include        <stdint.h>
+#include        <string.h>
+
+#include        "biquad.h"
+
+void biquad_section_init(biquad_section* section, const biquad_coeffs* coeffs)
+{
+    section->coeffs = *coeffs;
+    biquad_section_reset(section);
+}
+
+void biquad_section_reset(biquad_section* section)
+{
+    memset(section->state, 0, sizeof(section->state));
+}
+
+void biquad_df1_process(const biquad_coeffs* coeffs, int32_t* state, const int16_t* in, int16_t* out, size_t length)
+{
+    const int32_t a0 = coeffs->a0;
+    const int32_t a1 = coeffs->a1;
+    const int32_t a2 = coeffs->a2;
+    const int32_t b1 = coeffs->b1;
+    const int32_t b2 = coeffs->b2;
+    int32_t x1 = state[0u];
+    int32_t x2 = state[1u];
+    int32_t y1 = state[2u];
+    int32_t y2 = state[3u];
+
+    /* Five products of up to 31 bits each, so the sum is 64-bit, the same sum TDF2 builds up over three samples. */
+    for(size_t i = 0u; i < length; i++)
+    {
+        int32_t inTemp = in[i];
+        int32_t outTemp = biquad_saturate_q14_wide((int64_t)(inTemp * a0) + (x1 * a1) + (x2 * a2) - (y1 * b1) - (y2 * b2));
+        x2 = x1;
+        x1 = inTemp;
+        y2 = y1;
+        y1 = outTemp;
+        out[i] = (int16_t)outTemp;
+    }
+
+    state[0u] = x1;
+    state[1u] = x2;
+    state[2u] = y1;
+    state[3u] = y2;
+}
+
+void biquad_df2_process(const biquad_coeffs* coeffs, int32_t* state, const int16_t* in, int16_t* out, size_t length)
+{
+    const int32_t a0 = coeffs->a0;
+    const int32_t a1 = coeffs->a1;
+    const int32_t a2 = coeffs->a2;
+    const int32_t b1 = coeffs->b1;
+    const int32_t b2 = coeffs->b2;
+    int32_t w1 = state[0u];
+    int32_t w2 = state[1u];
+
+    /* w carries the pole gain before the zeros cut it back, about 12.5x for the highpass. It still fits in int32, but
+     * its products with the taps do not, so they and their sums are 64-bit. */
+    for(size_t i = 0u; i < length; i++)
+    {
+        int32_t w = (int32_t)in[i] - (int32_t)(((int64_t)w1 * b1 + (int64_t)w2 * b2) >> BIQUAD_COEFF_SHIFT);
+        out[i] = biquad_saturate_q14_wide((int64_t)w * a0 + (int64_t)w1 * a1 + (int64_t)w2 * a2);
+        w2 = w1;
+        w1 = w;
+    }
+
+    state[0u] = w1;
+    state[1u] = w2;
+}
+
+void biquad_tdf2_process(const biquad_coeffs* coeffs, int32_t* state, const int16_t* in, int16_t* out, size_t length)
+{
+    const int32_t a0 = coeffs->a0;
+    const int32_t a1 = coeffs->a1;
+    const int32_t a2 = coeffs->a2;
+    const int32_t b1 = coeffs->b1;
+    const int32_t b2 = coeffs->b2;
+    int64_t z1;
+    int64_t z2;
+
+    memcpy(&z1, &state[0u], sizeof(z1));
+    memcpy(&z2, &state[2u], sizeof(z2));
+    /* Each product fits in 31 bits, but a sum of three of them does not, so only the sums go 64-bit. */
+    for(size_t i = 0u; i < length; i++)
+    {
+        int32_t inTemp = in[i];
+        int32_t outTemp = biquad_saturate_q14_wide((int64_t)(inTemp * a0) + z1);
+        z1 = (int64_t)(inTemp * a1) + z2 - (b1 * outTemp);
+        z2 = (int64_t)(inTemp * a2) - (b2 * outTemp);
+        out[i] = (int16_t)outTemp;
+    }
+
+    memcpy(&state[0u], &z1, sizeof(z1));
+    memcpy(&state[2u], &z2, sizeof(z2));
+}
+
+#if BIQUAD_TOPOLOGY == BIQUAD_TOPOLOGY_DF1
+#define         SECTION_PROCESS         biquad_df1_process
+#elif BIQUAD_TOPOLOGY == BIQUAD_TOPOLOGY_DF2
+#define         SECTION_PROCESS         biquad_df2_process
+#else
+#define         SECTION_PROCESS         biquad_tdf2_process
+#endif
+
+void biquad_cascade_process(biquad_section* sections, size_t section_count, const int16_t* in, int16_t* out, size_t length)
+{
+    const int16_t* source = in;
+
+    if((section_count == 0u) && (in != out))
+    {
+        memmove(out, in, length * sizeof(int16_t));
+    }
+
+    /* Section-major order: each section sweeps the whole block with its coefficients and state in registers. */
+    for(size_t section_var = 0u; section_var < section_count; section_var++)
+    {
+        SECTION_PROCESS(&sections[section_var].coeffs, sections[section_var].state, source, out, length);
+        source = out;
+    }
+}
+
+void biquad_state_init(biquad_state* state, const biquad_coeffs* coeffs, size_t section_count)
+{
+    if(section_count > BIQUAD_MAX_SECTIONS)
+    {
+        section_count = BIQUAD_MAX_SECTIONS;
+    }
+    for(size_t i = 0u; i < section_count; i++)
+    {
+        biquad_section_init(&state->sections[i], &coeffs[i]);
+    }
+    state->section_count = section_count;
+}
+
+void biquad_state_reset(biquad_state* state)
+{
+    for(size_t i = 0u; i < state->section_count; i++)
+    {
+        biquad_section_reset(&state->sections[i]);
+    }
+}
+
+void biquad_process_block(biquad_state* state, const int16_t* in, int16_t* out, size_t length)
+{
+    biquad_cascade_process(state->sections, state->section_count, in, out, length);
+}
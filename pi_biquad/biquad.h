@@ -0,0 +1,98 @@
+#ifndef         _BIQUAD_H
+#define         _BIQUAD_H
+
+#include        <stddef.h>
+#include        <stdint.h>
+
+/* Coefficients are Q14, so the feedforward taps of a highpass (1, -2, 1) still fit in int16. */
+#define         BIQUAD_COEFF_SHIFT      14u
+#define         BIQUAD_MAX_SECTIONS     8u
+
+/* Section topology used by the cascade, fixed at compile time so the hot loop never dispatches. */
+#define         BIQUAD_TOPOLOGY_DF1     1
+#define         BIQUAD_TOPOLOGY_DF2     2
+#define         BIQUAD_TOPOLOGY_TDF2    3
+
+#ifndef         BIQUAD_TOPOLOGY
+#define         BIQUAD_TOPOLOGY         BIQUAD_TOPOLOGY_TDF2
+#endif
+
+/* DF1 keeps x[n-1], x[n-2], y[n-1], y[n-2]; DF2 keeps two internal values and TDF2 two 64-bit partial sums. */
+#define         BIQUAD_STATE_WORDS      4u
+
+/* Denominator is 1 + b1 z^-1 + b2 z^-2, so b1 and b2 are subtracted in the update. */
+typedef struct biquad_coeffs_s
+{
+    int16_t a0;
+    int16_t a1;
+    int16_t a2;
+    int16_t b1;
+    int16_t b2;
+} biquad_coeffs;
+
+/* One section of the BIQUAD_TOPOLOGY form. Its state persists across blocks. */
+typedef struct biquad_section_s
+{
+    biquad_coeffs coeffs;
+    int32_t state[BIQUAD_STATE_WORDS];
+} biquad_section;
+
+/* A cascade that keeps its state between calls, so a stream can be fed in blocks of any size. */
+typedef struct biquad_state_s
+{
+    biquad_section sections[BIQUAD_MAX_SECTIONS];
+    size_t section_count;
+} biquad_state;
+
+static inline int16_t biquad_saturate_q14(int32_t accumulator)
+{
+    int32_t output = accumulator >> BIQUAD_COEFF_SHIFT;
+
+    if(output > INT16_MAX)
+    {
+        return INT16_MAX;
+    }
+    if(output < INT16_MIN)
+    {
+        return INT16_MIN;
+    }
+    return (int16_t)output;
+}
+
+/* The same for sums that need more than 32 bits. */
+static inline int16_t biquad_saturate_q14_wide(int64_t accumulator)
+{
+    int64_t output = accumulator >> BIQUAD_COEFF_SHIFT;
+
+    if(output > INT16_MAX)
+    {
+        return INT16_MAX;
+    }
+    if(output < INT16_MIN)
+    {
+        return INT16_MIN;
+    }
+    return (int16_t)output;
+}
+
+void biquad_section_init(biquad_section* section, const biquad_coeffs* coeffs);
+void biquad_section_reset(biquad_section* section);
+
+/* Single-section kernels, one per topology. state must hold BIQUAD_STATE_WORDS zeroed words at the start of a stream. out may alias in.
+ * DF1 keeps plain samples as state, DF2 keeps the unscaled internal node w, TDF2 keeps Q14 scaled partial sums as
+ * two int64s, since they need up to 33 bits. */
+void biquad_df1_process(const biquad_coeffs* coeffs, int32_t* state, const int16_t* in, int16_t* out, size_t length);
+void biquad_df2_process(const biquad_coeffs* coeffs, int32_t* state, const int16_t* in, int16_t* out, size_t length);
+void biquad_tdf2_process(const biquad_coeffs* coeffs, int32_t* state, const int16_t* in, int16_t* out, size_t length);
+
+/* Runs length samples through section_count sections in order. out may alias in. */
+void biquad_cascade_process(biquad_section* sections, size_t section_count, const int16_t* in, int16_t* out, size_t length);
+
+/* coeffs holds one set per section. section_count is clamped to BIQUAD_MAX_SECTIONS. */
+void biquad_state_init(biquad_state* state, const biquad_coeffs* coeffs, size_t section_count);
+void biquad_state_reset(biquad_state* state);
+
+/* Filters the next length samples of the stream. Feeding a stream in blocks gives the same output as one call. */
+void biquad_process_block(biquad_state* state, const int16_t* in, int16_t* out, size_t length);
+
+#endif
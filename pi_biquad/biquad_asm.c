@@ -0,0 +1,59 @@
+#include        <stddef.h>
+#include        <stdint.h>
+
+#include        "biquad.h"
+#include        "biquad_asm.h"
+
+/* The adds in biquad_asm.S wrap modulo 2^32, so the sum is built in uint32_t, where that wrap is defined, and only
+ * reinterpreted as signed for the shift. */
+static int16_t wrapped_q14(int32_t p0, int32_t p1, int32_t p2, int32_t p3, int32_t p4)
+{
+    uint32_t sum = (uint32_t)p0 + (uint32_t)p1 + (uint32_t)p2 + (uint32_t)p3 + (uint32_t)p4;
+
+    return biquad_saturate_q14((int32_t)sum);
+}
+
+/* Host stand-in for biquad_asm.S, following its schedule: negated feedback taps, two samples a pass with each output
+ * accumulated over the y it replaces, and a single-sample tail for odd lengths. */
+void biquad_asm_process(const biquad_coeffs* coeffs, int32_t* state, const int16_t* in, int16_t* out, size_t length)
+{
+    const int32_t a0 = coeffs->a0;
+    const int32_t a1 = coeffs->a1;
+    const int32_t a2 = coeffs->a2;
+    const int32_t neg_b1 = -coeffs->b1;
+    const int32_t neg_b2 = -coeffs->b2;
+    int32_t x1 = state[0u];
+    int32_t x2 = state[1u];
+    int32_t y1 = state[2u];
+    int32_t y2 = state[3u];
+    size_t i = 0u;
+
+    for(; (i + 1u) < length; i = i + 2u)
+    {
+        int32_t first = in[i];
+        int32_t second = in[i + 1u];
+
+        y2 = wrapped_q14(neg_b2 * y2, a0 * first, a1 * x1, a2 * x2, neg_b1 * y1);
+        y1 = wrapped_q14(neg_b2 * y1, a0 * second, a1 * first, a2 * x1, neg_b1 * y2);
+        out[i] = (int16_t)y2;
+        out[i + 1u] = (int16_t)y1;
+        x2 = first;
+        x1 = second;
+    }
+    if(i < length)
+    {
+        int32_t last = in[i];
+        int32_t outTemp = wrapped_q14(neg_b2 * y2, a0 * last, a1 * x1, a2 * x2, neg_b1 * y1);
+
+        out[i] = (int16_t)outTemp;
+        x2 = x1;
+        x1 = last;
+        y2 = y1;
+        y1 = outTemp;
+    }
+
+    state[0u] = x1;
+    state[1u] = x2;
+    state[2u] = y1;
+    state[3u] = y2;
+}
@@ -0,0 +1,19 @@
+#ifndef         _BIQUAD_ASM_H
+#define         _BIQUAD_ASM_H
+
+#include        <stddef.h>
+#include        <stdint.h>
+
+#include        "biquad.h"
+
+/* Hand-scheduled Thumb-1 DF1 section, two samples per pass with coefficients pinned in r8-r12 and the samples in
+ * r2-r6. Same state layout and arguments as biquad_df1_process. On the board it is assembled from biquad_asm.S into
+ * SRAM; the host build uses a C transcription of the same schedule.
+ *
+ * The five products are summed in one 32-bit register, which wraps modulo 2^32 where biquad_df1_process saturates
+ * from a 64-bit sum. The two agree bit for bit while |a0*x0| + |a1*x1| + |a2*x2| + |b1*y1| + |b2*y2| < 2^31. That
+ * holds for any input when the five |coefficients| add up to less than 4.0 (65536 in Q14); the benchmark highpass
+ * adds up to 6.2, which still guarantees it for inputs within +-14725, since its outputs saturate at full scale. */
+void biquad_asm_process(const biquad_coeffs* coeffs, int32_t* state, const int16_t* in, int16_t* out, size_t length);
+
+#endif
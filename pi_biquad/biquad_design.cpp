@@ -0,0 +1,53 @@
+#include        <cstddef>
+
+#include        "biquad.h"
+#include        "biquad_design.h"
+#include        "biquad_design.hpp"
+
+namespace
+{
+    constexpr biquad_coeffs design_q14(biquad_filter_type type, double fc_hz, double q, double gain_db = 0.0)
+    {
+        return biquad_design_quantised(biquad_design_cookbook(type, BIQUAD_DESIGN_SAMPLE_RATE, fc_hz, q, gain_db));
+    }
+
+    constexpr biquad_coeffs lowpass_1k = design_q14(BIQUAD_LOWPASS, 1000.0, 0.7071);
+    constexpr biquad_coeffs highpass_80 = design_q14(BIQUAD_HIGHPASS, 80.0, 0.7071);
+    constexpr biquad_coeffs bandpass_2k = design_q14(BIQUAD_BANDPASS, 2000.0, 2.0);
+    constexpr biquad_coeffs notch_50 = design_q14(BIQUAD_NOTCH, 50.0, 10.0);
+    constexpr biquad_coeffs peaking_3k = design_q14(BIQUAD_PEAKING, 3000.0, 1.0, 6.0);
+    constexpr biquad_coeffs lowshelf_200 = design_q14(BIQUAD_LOWSHELF, 200.0, 0.7071, -6.0);
+    constexpr biquad_coeffs highshelf_8k = design_q14(BIQUAD_HIGHSHELF, 8000.0, 0.7071, 3.0);
+
+    /* The original pi_biquad section is the cookbook highpass at fs/20 with its (1, -2, 1) numerator left unnormalised. */
+    constexpr biquad_design_result original_design = biquad_design_cookbook(BIQUAD_HIGHPASS, 20.0, 1.0, 0.7071, 0.0);
+    constexpr biquad_coeffs original_section = biquad_design_quantised(biquad_design_result{ original_design.a0 / original_design.a0,
+        original_design.a1 / original_design.a0, original_design.a2 / original_design.a0, original_design.b1, original_design.b2 });
+
+    static_assert(original_section.a0 == 16384, "cookbook highpass a0 does not match the original section");
+    static_assert(original_section.a1 == -32768, "cookbook highpass a1 does not match the original section");
+    static_assert(original_section.a2 == 16384, "cookbook highpass a2 does not match the original section");
+    static_assert(original_section.b1 == -25576, "cookbook highpass b1 does not match the original section");
+    static_assert(original_section.b2 == 10508, "cookbook highpass b2 does not match the original section");
+}
+
+extern "C"
+{
+    const biquad_design_preset biquad_design_presets[] =
+    {
+        { "lowpass 1 kHz",              lowpass_1k },
+        { "highpass 80 Hz",             highpass_80 },
+        { "bandpass 2 kHz Q2",          bandpass_2k },
+        { "notch 50 Hz Q10",            notch_50 },
+        { "peaking 3 kHz +6 dB",        peaking_3k },
+        { "low shelf 200 Hz -6 dB",     lowshelf_200 },
+        { "high shelf 8 kHz +3 dB",     highshelf_8k },
+    };
+
+    const size_t biquad_design_preset_count = sizeof(biquad_design_presets) / sizeof(biquad_design_presets[0]);
+
+    biquad_coeffs biquad_design(biquad_filter_type type, double sample_rate_hz, double fc_hz, double q, double gain_db)
+    {
+        return biquad_design_quantised(biquad_design_cookbook(type, sample_rate_hz, fc_hz, q, gain_db));
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef         _BIQUAD_DESIGN_H
+#define         _BIQUAD_DESIGN_H
+
+#include        <stddef.h>
+
+#include        "biquad.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* RBJ audio EQ cookbook responses. */
+typedef enum biquad_filter_type_e
+{
+    BIQUAD_LOWPASS = 0,
+    BIQUAD_HIGHPASS,
+    BIQUAD_BANDPASS,
+    BIQUAD_NOTCH,
+    BIQUAD_PEAKING,
+    BIQUAD_LOWSHELF,
+    BIQUAD_HIGHSHELF
+} biquad_filter_type;
+
+typedef struct biquad_design_preset_s
+{
+    const char* name;
+    biquad_coeffs coeffs;
+} biquad_design_preset;
+
+/* Designed at compile time at BIQUAD_DESIGN_SAMPLE_RATE, so they cost nothing at startup. */
+#define         BIQUAD_DESIGN_SAMPLE_RATE       48000.0
+
+extern const biquad_design_preset biquad_design_presets[];
+extern const size_t biquad_design_preset_count;
+
+/* Runtime designer for retuning, quantised to Q14. gain_db is only used by the peaking and shelf types.
+ * Coefficients outside the Q14 range of +-2 saturate. */
+biquad_coeffs biquad_design(biquad_filter_type type, double sample_rate_hz, double fc_hz, double q, double gain_db);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
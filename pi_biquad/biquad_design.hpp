@@ -0,0 +1,170 @@
+#ifndef         _BIQUAD_DESIGN_HPP
+#define         _BIQUAD_DESIGN_HPP
+
+#include        <cstdint>
+
+#include        "biquad.h"
+#include        "biquad_design.h"
+
+/* constexpr versions of the few maths functions the cookbook needs; <cmath> is not constexpr in C++17. */
+namespace biquad_design_math
+{
+    constexpr double pi = 3.14159265358979323846;
+
+    constexpr double sin(double x)
+    {
+        while(x > pi)
+        {
+            x = x - (2.0 * pi);
+        }
+        while(x < -pi)
+        {
+            x = x + (2.0 * pi);
+        }
+
+        double term = x;
+        double sum = x;
+        for(int n = 1; n < 16; n++)
+        {
+            term = -term * x * x / ((2.0 * n) * (2.0 * n + 1.0));
+            sum = sum + term;
+        }
+        return sum;
+    }
+
+    constexpr double cos(double x)
+    {
+        return sin(x + (pi / 2.0));
+    }
+
+    constexpr double sqrt(double x)
+    {
+        if(x <= 0.0)
+        {
+            return 0.0;
+        }
+
+        double guess = (x > 1.0) ? x : 1.0;
+        for(int n = 0; n < 64; n++)
+        {
+            guess = 0.5 * (guess + x / guess);
+        }
+        return guess;
+    }
+
+    /* Halves the argument until the series converges fast, then squares back up. */
+    constexpr double exp(double x)
+    {
+        int halvings = 0;
+        while((x > 0.5) || (x < -0.5))
+        {
+            x = x / 2.0;
+            halvings = halvings + 1;
+        }
+
+        double term = 1.0;
+        double sum = 1.0;
+        for(int n = 1; n < 20; n++)
+        {
+            term = term * x / n;
+            sum = sum + term;
+        }
+        for(; halvings > 0; halvings--)
+        {
+            sum = sum * sum;
+        }
+        return sum;
+    }
+
+    constexpr double db_to_amplitude_sqrt(double gain_db)
+    {
+        /* 10^(gain_db / 40), the cookbook's A. */
+        return exp(gain_db * 2.30258509299404568402 / 40.0);
+    }
+}
+
+/* Normalised coefficients in the repo's naming: a is the numerator, b the denominator after a0 = 1. */
+struct biquad_design_result
+{
+    double a0, a1, a2, b1, b2;
+};
+
+constexpr biquad_design_result biquad_design_cookbook(biquad_filter_type type, double sample_rate_hz, double fc_hz, double q, double gain_db)
+{
+    const double w0 = 2.0 * biquad_design_math::pi * fc_hz / sample_rate_hz;
+    const double cos_w0 = biquad_design_math::cos(w0);
+    const double alpha = biquad_design_math::sin(w0) / (2.0 * q);
+    const double A = biquad_design_math::db_to_amplitude_sqrt(gain_db);
+    const double shelf = 2.0 * biquad_design_math::sqrt(A) * alpha;
+    double num0 = 1.0, num1 = 0.0, num2 = 0.0, den0 = 1.0, den1 = 0.0, den2 = 0.0;
+
+    switch(type)
+    {
+        case BIQUAD_LOWPASS:
+            num0 = (1.0 - cos_w0) / 2.0;    num1 = 1.0 - cos_w0;                        num2 = (1.0 - cos_w0) / 2.0;
+            den0 = 1.0 + alpha;             den1 = -2.0 * cos_w0;                       den2 = 1.0 - alpha;
+            break;
+        case BIQUAD_HIGHPASS:
+            num0 = (1.0 + cos_w0) / 2.0;    num1 = -(1.0 + cos_w0);                     num2 = (1.0 + cos_w0) / 2.0;
+            den0 = 1.0 + alpha;             den1 = -2.0 * cos_w0;                       den2 = 1.0 - alpha;
+            break;
+        case BIQUAD_BANDPASS:               /* constant 0 dB peak gain */
+            num0 = alpha;                   num1 = 0.0;                                 num2 = -alpha;
+            den0 = 1.0 + alpha;             den1 = -2.0 * cos_w0;                       den2 = 1.0 - alpha;
+            break;
+        case BIQUAD_NOTCH:
+            num0 = 1.0;                     num1 = -2.0 * cos_w0;                       num2 = 1.0;
+            den0 = 1.0 + alpha;             den1 = -2.0 * cos_w0;                       den2 = 1.0 - alpha;
+            break;
+        case BIQUAD_PEAKING:
+            num0 = 1.0 + alpha * A;         num1 = -2.0 * cos_w0;                       num2 = 1.0 - alpha * A;
+            den0 = 1.0 + alpha / A;         den1 = -2.0 * cos_w0;                       den2 = 1.0 - alpha / A;
+            break;
+        case BIQUAD_LOWSHELF:
+            num0 = A * ((A + 1.0) - (A - 1.0) * cos_w0 + shelf);
+            num1 = 2.0 * A * ((A - 1.0) - (A + 1.0) * cos_w0);
+            num2 = A * ((A + 1.0) - (A - 1.0) * cos_w0 - shelf);
+            den0 = (A + 1.0) + (A - 1.0) * cos_w0 + shelf;
+            den1 = -2.0 * ((A - 1.0) + (A + 1.0) * cos_w0);
+            den2 = (A + 1.0) + (A - 1.0) * cos_w0 - shelf;
+            break;
+        case BIQUAD_HIGHSHELF:
+            num0 = A * ((A + 1.0) + (A - 1.0) * cos_w0 + shelf);
+            num1 = -2.0 * A * ((A - 1.0) + (A + 1.0) * cos_w0);
+            num2 = A * ((A + 1.0) + (A - 1.0) * cos_w0 - shelf);
+            den0 = (A + 1.0) - (A - 1.0) * cos_w0 + shelf;
+            den1 = 2.0 * ((A - 1.0) - (A + 1.0) * cos_w0);
+            den2 = (A + 1.0) - (A - 1.0) * cos_w0 - shelf;
+            break;
+    }
+
+    return biquad_design_result{ num0 / den0, num1 / den0, num2 / den0, den1 / den0, den2 / den0 };
+}
+
+/* Rounds to FRACTION_BITS and saturates to int16, so FRACTION_BITS = BIQUAD_COEFF_SHIFT gives the engine's Q14. */
+template <unsigned FRACTION_BITS>
+constexpr int16_t biquad_design_quantise(double value)
+{
+    const double scaled = value * static_cast<double>(1u << FRACTION_BITS);
+    const double rounded = (scaled >= 0.0) ? (scaled + 0.5) : (scaled - 0.5);
+
+    if(rounded >= static_cast<double>(INT16_MAX))
+    {
+        return INT16_MAX;
+    }
+    if(rounded <= static_cast<double>(INT16_MIN))
+    {
+        return INT16_MIN;
+    }
+    return static_cast<int16_t>(rounded);
+}
+
+template <unsigned FRACTION_BITS = BIQUAD_COEFF_SHIFT>
+constexpr biquad_coeffs biquad_design_quantised(const biquad_design_result& design)
+{
+    return biquad_coeffs{ biquad_design_quantise<FRACTION_BITS>(design.a0), biquad_design_quantise<FRACTION_BITS>(design.a1),
+                          biquad_design_quantise<FRACTION_BITS>(design.a2), biquad_design_quantise<FRACTION_BITS>(design.b1),
+                          biquad_design_quantise<FRACTION_BITS>(design.b2) };
+}
+
+#endif
@@ -0,0 +1,94 @@
+#include        <stdbool.h>
+#include        <stdint.h>
+#include        <string.h>
+
+#include        "hardware/sync.h"
+
+#include        "biquad.h"
+#include        "biquad_eq.h"
+
+void biquad_eq_init(biquad_eq* eq, const biquad_coeffs* coeffs, size_t band_count, bool ramp)
+{
+    band_count = (band_count > BIQUAD_EQ_MAX_BANDS) ? BIQUAD_EQ_MAX_BANDS : band_count;
+    memcpy(eq->slots[0u], coeffs, band_count * sizeof(biquad_coeffs));
+    eq->published = 0u;
+    eq->acquired = 0u;
+    biquad_state_init(&eq->state, coeffs, band_count);
+    eq->band_count = band_count;
+    eq->ramp = ramp;
+    eq->swaps = 0u;
+}
+
+bool biquad_eq_publish(biquad_eq* eq, const biquad_coeffs* coeffs)
+{
+    uint32_t next = eq->published + 1u;
+
+    /* The free slot still holds the set before the current one, which the audio core may be copying until it
+     * acknowledges the current one. */
+    if(eq->acquired != eq->published)
+    {
+        return false;
+    }
+    __mem_fence_acquire();
+    memcpy(eq->slots[next & 1u], coeffs, eq->band_count * sizeof(biquad_coeffs));
+    __mem_fence_release();
+    eq->published = next;
+    return true;
+}
+
+static int16_t ramp_coeff(int16_t from, int16_t to, uint32_t step)
+{
+    return (int16_t)(from + ((((int32_t)to - from) * (int32_t)step) / (int32_t)BIQUAD_EQ_RAMP_STEPS));
+}
+
+void biquad_eq_process(biquad_eq* eq, const int16_t* in, int16_t* out, size_t length)
+{
+    uint32_t sequence = eq->published;
+    biquad_coeffs target[BIQUAD_EQ_MAX_BANDS];
+    biquad_coeffs start[BIQUAD_EQ_MAX_BANDS];
+    size_t step_length = length / BIQUAD_EQ_RAMP_STEPS;
+
+    if(sequence == eq->acquired)
+    {
+        biquad_process_block(&eq->state, in, out, length);
+        return;
+    }
+    /* Copy the set out and hand the slot back before filtering, so the writer is held up for as short as possible. */
+    __mem_fence_acquire();
+    memcpy(target, eq->slots[sequence & 1u], eq->band_count * sizeof(biquad_coeffs));
+    __mem_fence_release();
+    eq->acquired = sequence;
+    eq->swaps = eq->swaps + 1u;
+
+    if(!eq->ramp || (step_length == 0u))
+    {
+        for(size_t band = 0u; band < eq->band_count; band++)
+        {
+            eq->state.sections[band].coeffs = target[band];
+        }
+        biquad_process_block(&eq->state, in, out, length);
+        return;
+    }
+    for(size_t band = 0u; band < eq->band_count; band++)
+    {
+        start[band] = eq->state.sections[band].coeffs;
+    }
+    /* The state carries across each step, so only the coefficients move; the last step lands exactly on target. */
+    for(uint32_t step = 1u; step <= BIQUAD_EQ_RAMP_STEPS; step++)
+    {
+        size_t offset = (step - 1u) * step_length;
+        size_t count = (step == BIQUAD_EQ_RAMP_STEPS) ? (length - offset) : step_length;
+
+        for(size_t band = 0u; band < eq->band_count; band++)
+        {
+            biquad_coeffs* coeffs = &eq->state.sections[band].coeffs;
+
+            coeffs->a0 = ramp_coeff(start[band].a0, target[band].a0, step);
+            coeffs->a1 = ramp_coeff(start[band].a1, target[band].a1, step);
+            coeffs->a2 = ramp_coeff(start[band].a2, target[band].a2, step);
+            coeffs->b1 = ramp_coeff(start[band].b1, target[band].b1, step);
+            coeffs->b2 = ramp_coeff(start[band].b2, target[band].b2, step);
+        }
+        biquad_process_block(&eq->state, in + offset, out + offset, count);
+    }
+}
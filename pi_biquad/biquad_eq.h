@@ -0,0 +1,39 @@
+#ifndef         _BIQUAD_EQ_H
+#define         _BIQUAD_EQ_H
+
+#include        <stdbool.h>
+#include        <stddef.h>
+#include        <stdint.h>
+
+#include        "biquad.h"
+
+/* An N-band EQ, one cascade section per band, that one core retunes while the other filters with it. New sets go
+ * through two slots: set N lives in slots[N & 1], and the writer only reuses a slot once the audio core has taken
+ * the newer set, so neither side ever waits on a lock. */
+#define         BIQUAD_EQ_MAX_BANDS     BIQUAD_MAX_SECTIONS
+#define         BIQUAD_EQ_RAMP_STEPS    8u      /* sub-blocks a ramped swap is spread over */
+
+typedef struct biquad_eq_s
+{
+    biquad_coeffs slots[2u][BIQUAD_EQ_MAX_BANDS];
+    volatile uint32_t published;    /* newest set, written by the control core */
+    volatile uint32_t acquired;     /* set the audio core last took, written by the audio core */
+    biquad_state state;             /* audio core only from here on */
+    size_t band_count;
+    bool ramp;
+    uint32_t swaps;
+} biquad_eq;
+
+/* Starts with coeffs as set 0. band_count is clamped to BIQUAD_EQ_MAX_BANDS. With ramp, each swap moves the
+ * coefficients over BIQUAD_EQ_RAMP_STEPS parts of the block instead of stepping at its start. */
+void biquad_eq_init(biquad_eq* eq, const biquad_coeffs* coeffs, size_t band_count, bool ramp);
+
+/* Control core: publishes band_count new sets of coefficients. Returns false, without waiting, while the audio core
+ * has not yet taken the previous set. */
+bool biquad_eq_publish(biquad_eq* eq, const biquad_coeffs* coeffs);
+
+/* Audio core: takes the newest published set, if any, at the start of the block and filters the block. out may
+ * alias in. */
+void biquad_eq_process(biquad_eq* eq, const int16_t* in, int16_t* out, size_t length);
+
+#endif
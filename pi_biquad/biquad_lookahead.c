@@ -0,0 +1,144 @@
+#include        <math.h>
+#include        <stdbool.h>
+#include        <stdint.h>
+#include        <string.h>
+
+#include        "pico/multicore.h"
+
+#include        "biquad.h"
+#include        "biquad_lookahead.h"
+
+#define         LOOKAHEAD_TOKEN_RUN     0x1A4EAD01u
+#define         LOOKAHEAD_TOKEN_DONE    0x1A4EAD02u
+#define         LOOKAHEAD_TOKEN_END     0x1A4EAD03u
+
+/* Core 1's half of the current section, published before the FIFO token that hands it over. */
+typedef struct lookahead_work_s
+{
+    const biquad_coeffs* coeffs;
+    const int16_t* in;
+    int16_t* out;
+    size_t length;
+    int32_t end_state[BIQUAD_STATE_WORDS];
+} lookahead_work;
+
+static volatile lookahead_work work;
+
+/* Zero-input response of the quantised poles in double precision, starting from full-scale output history. */
+static size_t tail_length(const biquad_coeffs* coeffs)
+{
+    const double scale = 1.0 / (double)(1u << BIQUAD_COEFF_SHIFT);
+    double y1 = INT16_MAX, y2 = INT16_MAX;
+    size_t quiet = 0u;
+    size_t length = 0u;
+
+    while((quiet < 2u) && (length < BIQUAD_LOOKAHEAD_TAIL_LIMIT))
+    {
+        double outTemp = -(coeffs->b1 * y1 + coeffs->b2 * y2) * scale;
+
+        quiet = (fabs(outTemp) < 0.5) ? (quiet + 1u) : 0u;
+        y2 = y1;
+        y1 = outTemp;
+        length = length + 1u;
+    }
+    return length;
+}
+
+void biquad_lookahead_init(biquad_lookahead* state, const biquad_coeffs* coeffs, size_t section_count)
+{
+    memset(state, 0, sizeof(*state));
+    state->section_count = (section_count < BIQUAD_MAX_SECTIONS) ? section_count : BIQUAD_MAX_SECTIONS;
+    for(size_t section = 0u; section < state->section_count; section++)
+    {
+        state->coeffs[section] = coeffs[section];
+        state->tail_length[section] = tail_length(&coeffs[section]);
+    }
+}
+
+/* Reruns the second half from the true state until it merges with core 1's output. Returns the samples it took. */
+static size_t fix_up(biquad_lookahead* state, size_t section, const int16_t* in, int16_t* out, size_t length)
+{
+    int16_t chunk[BIQUAD_LOOKAHEAD_CHUNK];
+    bool previous_match = false;
+
+    for(size_t offset = 0u; offset < length; offset = offset + BIQUAD_LOOKAHEAD_CHUNK)
+    {
+        size_t chunk_length = ((length - offset) < BIQUAD_LOOKAHEAD_CHUNK) ? (length - offset) : BIQUAD_LOOKAHEAD_CHUNK;
+
+        biquad_df1_process(&state->coeffs[section], state->state[section], in + offset, chunk, chunk_length);
+        for(size_t i = 0u; i < chunk_length; i++)
+        {
+            bool match = chunk[i] == out[offset + i];
+
+            if(match && previous_match)
+            {
+                for(size_t loop_var = 0u; loop_var < BIQUAD_STATE_WORDS; loop_var++)
+                {
+                    state->state[section][loop_var] = work.end_state[loop_var];
+                }
+                return offset + i + 1u;
+            }
+            out[offset + i] = chunk[i];
+            previous_match = match;
+        }
+    }
+    state->unmerged_sections = state->unmerged_sections + 1u;
+    return length;
+}
+
+void biquad_lookahead_process(biquad_lookahead* state, const int16_t* in, int16_t* out, int16_t* scratch, size_t length)
+{
+    size_t half = length / 2u;
+    /* Sections ping-pong between out and scratch, starting so that the last one lands in out. */
+    int16_t* destination = ((state->section_count % 2u) != 0u) ? out : scratch;
+    const int16_t* source = in;
+
+    if(state->section_count == 0u)
+    {
+        memcpy(out, in, length * sizeof(int16_t));
+        return;
+    }
+#if !BIQUAD_LOOKAHEAD_PARALLEL
+    for(size_t section = 0u; section < state->section_count; section++)
+    {
+        biquad_df2_process(&state->coeffs[section], state->state[section], source, out, length);
+        source = out;
+    }
+    return;
+#endif
+    for(size_t section = 0u; section < state->section_count; section++)
+    {
+        work.coeffs = &state->coeffs[section];
+        work.in = source + half;
+        work.out = destination + half;
+        work.length = length - half;
+        multicore_fifo_push_blocking(LOOKAHEAD_TOKEN_RUN);
+
+        biquad_df1_process(&state->coeffs[section], state->state[section], source, destination, half);
+        while(multicore_fifo_pop_blocking() != LOOKAHEAD_TOKEN_DONE);
+        state->fixup_samples = state->fixup_samples + fix_up(state, section, source + half, destination + half, length - half);
+
+        source = destination;
+        destination = (destination == out) ? scratch : out;
+    }
+}
+
+void biquad_lookahead_worker(void)
+{
+    while(multicore_fifo_pop_blocking() == LOOKAHEAD_TOKEN_RUN)
+    {
+        int32_t state[BIQUAD_STATE_WORDS] = { 0 };
+
+        biquad_df1_process(work.coeffs, state, work.in, work.out, work.length);
+        for(size_t loop_var = 0u; loop_var < BIQUAD_STATE_WORDS; loop_var++)
+        {
+            work.end_state[loop_var] = state[loop_var];
+        }
+        multicore_fifo_push_blocking(LOOKAHEAD_TOKEN_DONE);
+    }
+}
+
+void biquad_lookahead_stop(void)
+{
+    multicore_fifo_push_blocking(LOOKAHEAD_TOKEN_END);
+}
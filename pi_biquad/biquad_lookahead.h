@@ -0,0 +1,44 @@
+#ifndef         _BIQUAD_LOOKAHEAD_H
+#define         _BIQUAD_LOOKAHEAD_H
+
+#include        <stddef.h>
+#include        <stdint.h>
+
+#include        "biquad.h"
+
+/* Block-parallel single channel. For each section core 0 filters the first half of the block from the true state
+ * while core 1 filters the second half from zero state. A fix-up on core 0 then reruns the second half from core 0's
+ * end state until both runs agree on two consecutive outputs: DF1 state is just the last two inputs and outputs, so
+ * from there on core 1's samples are exactly the serial ones. With truncation and saturation the output is not linear
+ * in the state, so this replaces the usual "add the zero-input response" correction and keeps it bit-exact.
+ *
+ * The halves always run as DF1, and that matches biquad_process_block only because DF1 and TDF2 saturate the same
+ * exact 64-bit sum of the same five products, so they agree sample for sample at any level. DF2 truncates its
+ * internal node and has no such twin, so under BIQUAD_TOPOLOGY_DF2 the block is filtered serially on core 0 with
+ * biquad_df2_process and core 1 only waits for the stop token. */
+#define         BIQUAD_LOOKAHEAD_PARALLEL       (BIQUAD_TOPOLOGY != BIQUAD_TOPOLOGY_DF2)
+#define         BIQUAD_LOOKAHEAD_CHUNK  16u
+#define         BIQUAD_LOOKAHEAD_TAIL_LIMIT     65536u
+
+typedef struct biquad_lookahead_s
+{
+    biquad_coeffs coeffs[BIQUAD_MAX_SECTIONS];
+    int32_t state[BIQUAD_MAX_SECTIONS][BIQUAD_STATE_WORDS];
+    size_t tail_length[BIQUAD_MAX_SECTIONS];    /* samples for a full-scale state to decay below half an LSB */
+    size_t section_count;
+    uint64_t fixup_samples;                     /* summed over all sections of all blocks */
+    uint64_t unmerged_sections;                 /* fix-ups that ran to the end of the block */
+} biquad_lookahead;
+
+/* section_count is clamped to BIQUAD_MAX_SECTIONS. tail_length is worked out here, in double precision. */
+void biquad_lookahead_init(biquad_lookahead* state, const biquad_coeffs* coeffs, size_t section_count);
+
+/* Core 0 side: filters the next length samples of the stream, same output as biquad_process_block. out must not
+ * alias in, and scratch holds length samples. Core 1 must be inside biquad_lookahead_worker. */
+void biquad_lookahead_process(biquad_lookahead* state, const int16_t* in, int16_t* out, int16_t* scratch, size_t length);
+
+/* Core 1 side: serves second halves until core 0 calls biquad_lookahead_stop. Owns the FIFO meanwhile. */
+void biquad_lookahead_worker(void);
+void biquad_lookahead_stop(void);
+
+#endif
@@ -0,0 +1,133 @@
+#include        <stdint.h>
+#include        <string.h>
+
+#include        "biquad.h"
+#include        "biquad_multichannel.h"
+
+/* Two channels per pass: both states sit in registers next to the shared coefficients. The sums are 64-bit, as in
+ * biquad_tdf2_process, so every channel matches a mono pass bit for bit. */
+static void process_channel_pair(const biquad_coeffs* coeffs, int64_t* z1, int64_t* z2, const int16_t* in_a, const int16_t* in_b,
+                                 int16_t* out_a, int16_t* out_b, size_t stride, size_t frames)
+{
+    const int32_t a0 = coeffs->a0;
+    const int32_t a1 = coeffs->a1;
+    const int32_t a2 = coeffs->a2;
+    const int32_t b1 = coeffs->b1;
+    const int32_t b2 = coeffs->b2;
+    int64_t z1_a = z1[0u], z2_a = z2[0u];
+    int64_t z1_b = z1[1u], z2_b = z2[1u];
+
+    for(size_t i = 0u; i < frames * stride; i = i + stride)
+    {
+        int32_t inTemp_a = in_a[i];
+        int32_t inTemp_b = in_b[i];
+        int32_t outTemp_a = biquad_saturate_q14_wide((int64_t)(inTemp_a * a0) + z1_a);
+        int32_t outTemp_b = biquad_saturate_q14_wide((int64_t)(inTemp_b * a0) + z1_b);
+        z1_a = (int64_t)(inTemp_a * a1) + z2_a - (b1 * outTemp_a);
+        z1_b = (int64_t)(inTemp_b * a1) + z2_b - (b1 * outTemp_b);
+        z2_a = (int64_t)(inTemp_a * a2) - (b2 * outTemp_a);
+        z2_b = (int64_t)(inTemp_b * a2) - (b2 * outTemp_b);
+        out_a[i] = (int16_t)outTemp_a;
+        out_b[i] = (int16_t)outTemp_b;
+    }
+
+    z1[0u] = z1_a;
+    z2[0u] = z2_a;
+    z1[1u] = z1_b;
+    z2[1u] = z2_b;
+}
+
+static void process_channel(const biquad_coeffs* coeffs, int64_t* z1, int64_t* z2, const int16_t* in, int16_t* out, size_t stride, size_t frames)
+{
+    const int32_t a0 = coeffs->a0;
+    const int32_t a1 = coeffs->a1;
+    const int32_t a2 = coeffs->a2;
+    const int32_t b1 = coeffs->b1;
+    const int32_t b2 = coeffs->b2;
+    int64_t z1_a = *z1, z2_a = *z2;
+
+    for(size_t i = 0u; i < frames * stride; i = i + stride)
+    {
+        int32_t inTemp = in[i];
+        int32_t outTemp = biquad_saturate_q14_wide((int64_t)(inTemp * a0) + z1_a);
+        z1_a = (int64_t)(inTemp * a1) + z2_a - (b1 * outTemp);
+        z2_a = (int64_t)(inTemp * a2) - (b2 * outTemp);
+        out[i] = (int16_t)outTemp;
+    }
+
+    *z1 = z1_a;
+    *z2 = z2_a;
+}
+
+void biquad_multichannel_init(biquad_multichannel* state, const biquad_coeffs* coeffs, size_t section_count, size_t channel_count)
+{
+    state->section_count = (section_count > BIQUAD_MAX_SECTIONS) ? BIQUAD_MAX_SECTIONS : section_count;
+    state->channel_count = (channel_count > BIQUAD_MAX_CHANNELS) ? BIQUAD_MAX_CHANNELS : channel_count;
+    memcpy(state->coeffs, coeffs, state->section_count * sizeof(biquad_coeffs));
+    biquad_multichannel_reset(state);
+}
+
+void biquad_multichannel_reset(biquad_multichannel* state)
+{
+    memset(state->z1, 0, sizeof(state->z1));
+    memset(state->z2, 0, sizeof(state->z2));
+}
+
+void biquad_process_interleaved(biquad_multichannel* state, const int16_t* in, int16_t* out, size_t frames)
+{
+    size_t channel_count = state->channel_count;
+    const int16_t* source = in;
+
+    if((state->section_count == 0u) && (in != out))
+    {
+        memmove(out, in, frames * channel_count * sizeof(int16_t));
+    }
+
+    for(size_t section_var = 0u; section_var < state->section_count; section_var++)
+    {
+        size_t channel = 0u;
+
+        for(; channel + 1u < channel_count; channel = channel + 2u)
+        {
+            process_channel_pair(&state->coeffs[section_var], &state->z1[section_var][channel], &state->z2[section_var][channel],
+                                 source + channel, source + channel + 1u, out + channel, out + channel + 1u, channel_count, frames);
+        }
+        if(channel < channel_count)
+        {
+            process_channel(&state->coeffs[section_var], &state->z1[section_var][channel], &state->z2[section_var][channel],
+                            source + channel, out + channel, channel_count, frames);
+        }
+        source = out;
+    }
+}
+
+void biquad_process_planar(biquad_multichannel* state, const int16_t* const* in, int16_t* const* out, size_t frames)
+{
+    size_t channel_count = state->channel_count;
+
+    for(size_t channel = 0u; channel < channel_count; channel++)
+    {
+        if((state->section_count == 0u) && (in[channel] != out[channel]))
+        {
+            memmove(out[channel], in[channel], frames * sizeof(int16_t));
+        }
+    }
+
+    for(size_t section_var = 0u; section_var < state->section_count; section_var++)
+    {
+        size_t channel = 0u;
+
+        /* After the first section every channel reads its own output buffer. */
+        for(; channel + 1u < channel_count; channel = channel + 2u)
+        {
+            process_channel_pair(&state->coeffs[section_var], &state->z1[section_var][channel], &state->z2[section_var][channel],
+                                 (section_var == 0u) ? in[channel] : out[channel], (section_var == 0u) ? in[channel + 1u] : out[channel + 1u],
+                                 out[channel], out[channel + 1u], 1u, frames);
+        }
+        if(channel < channel_count)
+        {
+            process_channel(&state->coeffs[section_var], &state->z1[section_var][channel], &state->z2[section_var][channel],
+                            (section_var == 0u) ? in[channel] : out[channel], out[channel], 1u, frames);
+        }
+    }
+}
@@ -0,0 +1,31 @@
+#ifndef         _BIQUAD_MULTICHANNEL_H
+#define         _BIQUAD_MULTICHANNEL_H
+
+#include        <stddef.h>
+#include        <stdint.h>
+
+#include        "biquad.h"
+
+#define         BIQUAD_MAX_CHANNELS     8u
+
+/* The same cascade applied to several synchronised channels, each with its own state. */
+typedef struct biquad_multichannel_s
+{
+    biquad_coeffs coeffs[BIQUAD_MAX_SECTIONS];
+    int64_t z1[BIQUAD_MAX_SECTIONS][BIQUAD_MAX_CHANNELS];   /* TDF2 partial sums, as in biquad_tdf2_process */
+    int64_t z2[BIQUAD_MAX_SECTIONS][BIQUAD_MAX_CHANNELS];
+    size_t section_count;
+    size_t channel_count;
+} biquad_multichannel;
+
+/* section_count and channel_count are clamped to BIQUAD_MAX_SECTIONS and BIQUAD_MAX_CHANNELS. */
+void biquad_multichannel_init(biquad_multichannel* state, const biquad_coeffs* coeffs, size_t section_count, size_t channel_count);
+void biquad_multichannel_reset(biquad_multichannel* state);
+
+/* Interleaved frames: in[frame * channel_count + channel]. out may alias in. */
+void biquad_process_interleaved(biquad_multichannel* state, const int16_t* in, int16_t* out, size_t frames);
+
+/* Planar: one buffer per channel. out[channel] may alias in[channel]. */
+void biquad_process_planar(biquad_multichannel* state, const int16_t* const* in, int16_t* const* out, size_t frames);
+
+#endif
@@ -0,0 +1,166 @@
+#include        <stdint.h>
+
+#include        "biquad.h"
+#include        "biquad_precision.h"
+
+/* Q28 keeps the five-product sum under 2^63 for any Q14 set: a tap is at most 2 in magnitude, so each product is at
+ * most 2^60. Q30 would gain nothing, since the coefficients come from Q14. */
+#define         Q31_COEFF_SHIFT         28u
+#define         Q31_SAMPLE_SHIFT        16u
+
+static inline int32_t saturate_q31(int64_t accumulator)
+{
+    int64_t output = accumulator >> Q31_COEFF_SHIFT;
+
+    if(output > INT32_MAX)
+    {
+        return INT32_MAX;
+    }
+    if(output < INT32_MIN)
+    {
+        return INT32_MIN;
+    }
+    return (int32_t)output;
+}
+
+static inline int16_t float_to_sample(float value)
+{
+    if(value >= (float)INT16_MAX)
+    {
+        return INT16_MAX;
+    }
+    if(value <= (float)INT16_MIN)
+    {
+        return INT16_MIN;
+    }
+    return (int16_t)((value >= 0.0f) ? (value + 0.5f) : (value - 0.5f));
+}
+
+static inline int16_t double_to_sample(double value)
+{
+    if(value >= (double)INT16_MAX)
+    {
+        return INT16_MAX;
+    }
+    if(value <= (double)INT16_MIN)
+    {
+        return INT16_MIN;
+    }
+    return (int16_t)((value >= 0.0) ? (value + 0.5) : (value - 0.5));
+}
+
+void biquad_q31_init(biquad_q31_section* section, const biquad_coeffs* coeffs)
+{
+    const unsigned shift = Q31_COEFF_SHIFT - BIQUAD_COEFF_SHIFT;
+
+    section->a0 = (int32_t)((uint32_t)(int32_t)coeffs->a0 << shift);
+    section->a1 = (int32_t)((uint32_t)(int32_t)coeffs->a1 << shift);
+    section->a2 = (int32_t)((uint32_t)(int32_t)coeffs->a2 << shift);
+    section->b1 = (int32_t)((uint32_t)(int32_t)coeffs->b1 << shift);
+    section->b2 = (int32_t)((uint32_t)(int32_t)coeffs->b2 << shift);
+    section->x1 = 0;
+    section->x2 = 0;
+    section->y1 = 0;
+    section->y2 = 0;
+}
+
+void biquad_f32_init(biquad_f32_section* section, const biquad_coeffs* coeffs)
+{
+    const float scale = 1.0f / (float)(1u << BIQUAD_COEFF_SHIFT);
+
+    section->a0 = coeffs->a0 * scale;
+    section->a1 = coeffs->a1 * scale;
+    section->a2 = coeffs->a2 * scale;
+    section->b1 = coeffs->b1 * scale;
+    section->b2 = coeffs->b2 * scale;
+    section->z1 = 0.0f;
+    section->z2 = 0.0f;
+}
+
+void biquad_f64_init(biquad_f64_section* section, const biquad_coeffs* coeffs)
+{
+    const double scale = 1.0 / (double)(1u << BIQUAD_COEFF_SHIFT);
+
+    section->a0 = coeffs->a0 * scale;
+    section->a1 = coeffs->a1 * scale;
+    section->a2 = coeffs->a2 * scale;
+    section->b1 = coeffs->b1 * scale;
+    section->b2 = coeffs->b2 * scale;
+    section->z1 = 0.0;
+    section->z2 = 0.0;
+}
+
+void biquad_q31_process(biquad_q31_section* section, const int16_t* in, int16_t* out, size_t length)
+{
+    const int64_t a0 = section->a0;
+    const int64_t a1 = section->a1;
+    const int64_t a2 = section->a2;
+    const int64_t b1 = section->b1;
+    const int64_t b2 = section->b2;
+    int32_t x1 = section->x1;
+    int32_t x2 = section->x2;
+    int32_t y1 = section->y1;
+    int32_t y2 = section->y2;
+
+    for(size_t i = 0u; i < length; i++)
+    {
+        int32_t inTemp = (int32_t)((uint32_t)(int32_t)in[i] << Q31_SAMPLE_SHIFT);
+        int32_t outTemp = saturate_q31(a0 * inTemp + a1 * x1 + a2 * x2 - b1 * y1 - b2 * y2);
+        x2 = x1;
+        x1 = inTemp;
+        y2 = y1;
+        y1 = outTemp;
+        out[i] = (int16_t)(outTemp >> Q31_SAMPLE_SHIFT);
+    }
+
+    section->x1 = x1;
+    section->x2 = x2;
+    section->y1 = y1;
+    section->y2 = y2;
+}
+
+void biquad_f32_process(biquad_f32_section* section, const int16_t* in, int16_t* out, size_t length)
+{
+    const float a0 = section->a0;
+    const float a1 = section->a1;
+    const float a2 = section->a2;
+    const float b1 = section->b1;
+    const float b2 = section->b2;
+    float z1 = section->z1;
+    float z2 = section->z2;
+
+    for(size_t i = 0u; i < length; i++)
+    {
+        float inTemp = in[i];
+        float outTemp = inTemp * a0 + z1;
+        z1 = inTemp * a1 + z2 - b1 * outTemp;
+        z2 = inTemp * a2 - b2 * outTemp;
+        out[i] = float_to_sample(outTemp);
+    }
+
+    section->z1 = z1;
+    section->z2 = z2;
+}
+
+void biquad_f64_process(biquad_f64_section* section, const int16_t* in, int16_t* out, size_t length)
+{
+    const double a0 = section->a0;
+    const double a1 = section->a1;
+    const double a2 = section->a2;
+    const double b1 = section->b1;
+    const double b2 = section->b2;
+    double z1 = section->z1;
+    double z2 = section->z2;
+
+    for(size_t i = 0u; i < length; i++)
+    {
+        double inTemp = in[i];
+        double outTemp = inTemp * a0 + z1;
+        z1 = inTemp * a1 + z2 - b1 * outTemp;
+        z2 = inTemp * a2 - b2 * outTemp;
+        out[i] = double_to_sample(outTemp);
+    }
+
+    section->z1 = z1;
+    section->z2 = z2;
+}
@@ -0,0 +1,41 @@
+#ifndef         _BIQUAD_PRECISION_H
+#define         _BIQUAD_PRECISION_H
+
+#include        <stddef.h>
+#include        <stdint.h>
+
+#include        "biquad.h"
+
+/* Q14 has no kernel of its own: biquad_df1_process is the Q14 DF1 with a 32-bit accumulator. */
+
+/* DF1 with Q28 coefficients and Q31 state, summed in a 64-bit accumulator. */
+typedef struct biquad_q31_section_s
+{
+    int32_t a0, a1, a2, b1, b2;
+    int32_t x1, x2, y1, y2;
+} biquad_q31_section;
+
+/* TDF2 in single precision. On the RP2040 the SDK routes float maths through the ROM routines. */
+typedef struct biquad_f32_section_s
+{
+    float a0, a1, a2, b1, b2;
+    float z1, z2;
+} biquad_f32_section;
+
+/* TDF2 in double precision, built against libgcc's soft-float rather than the ROM-assisted SDK version. */
+typedef struct biquad_f64_section_s
+{
+    double a0, a1, a2, b1, b2;
+    double z1, z2;
+} biquad_f64_section;
+
+/* All of them take the Q14 coefficient set and zero their state. Samples stay int16 in and out. */
+void biquad_q31_init(biquad_q31_section* section, const biquad_coeffs* coeffs);
+void biquad_f32_init(biquad_f32_section* section, const biquad_coeffs* coeffs);
+void biquad_f64_init(biquad_f64_section* section, const biquad_coeffs* coeffs);
+
+void biquad_q31_process(biquad_q31_section* section, const int16_t* in, int16_t* out, size_t length);
+void biquad_f32_process(biquad_f32_section* section, const int16_t* in, int16_t* out, size_t length);
+void biquad_f64_process(biquad_f64_section* section, const int16_t* in, int16_t* out, size_t length);
+
+#endif
@@ -0,0 +1,64 @@
+#include        <stddef.h>
+#include        <stdint.h>
+#include        <string.h>
+
+#include        "biquad.h"
+#include        "biquad_swar.h"
+
+void biquad_swar_init(biquad_swar_section* section, const biquad_coeffs* coeffs)
+{
+    section->coeffs = *coeffs;
+    section->x1 = 0u;
+    section->x2 = 0u;
+    section->y1 = 0u;
+    section->y2 = 0u;
+}
+
+static void process_section(biquad_swar_section* section, const uint32_t* in, uint32_t* out, size_t frames)
+{
+    const int32_t a0 = section->coeffs.a0;
+    const int32_t a1 = section->coeffs.a1;
+    const int32_t a2 = section->coeffs.a2;
+    const int32_t b1 = section->coeffs.b1;
+    const int32_t b2 = section->coeffs.b2;
+    uint32_t x1 = section->x1;
+    uint32_t x2 = section->x2;
+    uint32_t y1 = section->y1;
+    uint32_t y2 = section->y2;
+
+    for(size_t i = 0u; i < frames; i++)
+    {
+        uint32_t inTemp = in[i];
+        int64_t left = (int64_t)(biquad_swar_left(inTemp) * a0) + (biquad_swar_left(x1) * a1) + (biquad_swar_left(x2) * a2)
+                       - (biquad_swar_left(y1) * b1) - (biquad_swar_left(y2) * b2);
+        int64_t right = (int64_t)(biquad_swar_right(inTemp) * a0) + (biquad_swar_right(x1) * a1) + (biquad_swar_right(x2) * a2)
+                        - (biquad_swar_right(y1) * b1) - (biquad_swar_right(y2) * b2);
+        uint32_t outTemp = biquad_swar_pack(biquad_saturate_q14_wide(left), biquad_saturate_q14_wide(right));
+
+        x2 = x1;
+        x1 = inTemp;
+        y2 = y1;
+        y1 = outTemp;
+        out[i] = outTemp;
+    }
+
+    section->x1 = x1;
+    section->x2 = x2;
+    section->y1 = y1;
+    section->y2 = y2;
+}
+
+void biquad_swar_process(biquad_swar_section* sections, size_t section_count, const uint32_t* in, uint32_t* out, size_t frames)
+{
+    const uint32_t* source = in;
+
+    if((section_count == 0u) && (in != out))
+    {
+        memmove(out, in, frames * sizeof(uint32_t));
+    }
+    for(size_t section_var = 0u; section_var < section_count; section_var++)
+    {
+        process_section(&sections[section_var], source, out, frames);
+        source = out;
+    }
+}
@@ -0,0 +1,39 @@
+#ifndef         _BIQUAD_SWAR_H
+#define         _BIQUAD_SWAR_H
+
+#include        <stddef.h>
+#include        <stdint.h>
+
+#include        "biquad.h"
+
+/* Two channels in one word, left in the low half and right in the high half, the layout of interleaved int16 stereo.
+ * Loads, stores and the DF1 history shuffle move both lanes at once; the multiplies stay one per lane, since a Q14
+ * product needs 30 bits and leaves no guard bits for a second lane in 32. Each lane sums its products in 64 bits and
+ * saturates from there, like biquad_df1_process, so it is bit-exact with two mono DF1/TDF2 passes at any level. */
+typedef struct biquad_swar_section_s
+{
+    biquad_coeffs coeffs;
+    uint32_t x1, x2, y1, y2;
+} biquad_swar_section;
+
+static inline uint32_t biquad_swar_pack(int16_t left, int16_t right)
+{
+    return (uint32_t)(uint16_t)left | ((uint32_t)(uint16_t)right << 16u);
+}
+
+static inline int16_t biquad_swar_left(uint32_t frame)
+{
+    return (int16_t)(frame & 0xFFFFu);
+}
+
+static inline int16_t biquad_swar_right(uint32_t frame)
+{
+    return (int16_t)(frame >> 16u);
+}
+
+void biquad_swar_init(biquad_swar_section* section, const biquad_coeffs* coeffs);
+
+/* Runs frames packed frames through section_count sections in order. out may alias in. */
+void biquad_swar_process(biquad_swar_section* sections, size_t section_count, const uint32_t* in, uint32_t* out, size_t frames);
+
+#endif
@@ -0,0 +1,370 @@
+#include        <math.h>
+#include        <stdint.h>
+#include        <string.h>
+
+#include        "pico/multicore.h"
+
+#include        "fft.h"
+
+#define         FFT_TOKEN_STAGE         0xFF7A0001u
+#define         FFT_TOKEN_QUARTERS      0xFF7A0002u
+#define         FFT_TOKEN_DONE          0xFF7A0003u
+#define         FFT_TOKEN_END           0xFF7A0004u
+
+#define         RADIX4_LIMIT            4095    /* four inputs and a twiddle grow a component by at most 4 * sqrt(2) */
+#define         RADIX2_LIMIT            16383
+#define         REAL_SPLIT_LIMIT        13573   /* E + W O grows a component by at most 1 + sqrt(2) */
+
+/* W^k = cos(2 pi k / N) - j sin(2 pi k / N) for N = FFT_MAX_POINTS, as re, im pairs. Not const, so it stays in SRAM. */
+static int16_t fft_twiddles[2u * ((3u * FFT_MAX_POINTS) / 4u)];
+
+/* The part of a two-core transform handed to core 1, published before the FIFO token. */
+typedef struct fft_work_s
+{
+    int16_t* data;
+    size_t points;
+    unsigned shift;
+    int32_t quarter_max[4u];
+    int exponents[2u];
+} fft_work;
+
+static volatile fft_work work;
+
+void fft_init(void)
+{
+    const double pi = 3.14159265358979323846;
+
+    for(size_t k = 0u; k < ((3u * FFT_MAX_POINTS) / 4u); k++)
+    {
+        double angle = (2.0 * pi * k) / FFT_MAX_POINTS;
+
+        fft_twiddles[2u * k] = (int16_t)floor(cos(angle) * 32767.0 + 0.5);
+        fft_twiddles[(2u * k) + 1u] = (int16_t)floor(-sin(angle) * 32767.0 + 0.5);
+    }
+}
+
+static inline int32_t magnitude(int32_t value)
+{
+    return (value < 0) ? -value : value;
+}
+
+static unsigned headroom_shift(int32_t max, int32_t limit)
+{
+    unsigned shift = 0u;
+
+    while((max >> shift) > limit)
+    {
+        shift = shift + 1u;
+    }
+    return shift;
+}
+
+static int32_t block_max(const int16_t* data, size_t points)
+{
+    int32_t max = 0;
+
+    for(size_t i = 0u; i < 2u * points; i++)
+    {
+        max = (magnitude(data[i]) > max) ? magnitude(data[i]) : max;
+    }
+    return max;
+}
+
+/* Q15 complex multiply with rounding, result back in re and im. */
+static inline void twiddle(int32_t* re, int32_t* im, size_t index)
+{
+    int32_t wr = fft_twiddles[2u * index];
+    int32_t wi = fft_twiddles[(2u * index) + 1u];
+    int32_t r = *re;
+    int32_t i = *im;
+
+    *re = ((r * wr) - (i * wi) + (1 << 14)) >> 15;
+    *im = ((r * wi) + (i * wr) + (1 << 14)) >> 15;
+}
+
+/* Radix-4 DIF butterflies j_begin to j_end - 1 of every length-point group in a block of points. Each output slot's
+ * largest component goes to slot_max, slot 1 holding y2 and slot 2 y1 for the bit-reversed order. */
+static void radix4_stage(int16_t* data, size_t points, size_t length, unsigned shift, size_t j_begin, size_t j_end, int32_t* slot_max)
+{
+    size_t quarter = length / 4u;
+    size_t stride = FFT_MAX_POINTS / length;
+
+    for(size_t group = 0u; group < points; group = group + length)
+    {
+        for(size_t j = j_begin; j < j_end; j++)
+        {
+            int16_t* a = &data[2u * (group + j)];
+            int16_t* b = a + (2u * quarter);
+            int16_t* c = b + (2u * quarter);
+            int16_t* d = c + (2u * quarter);
+            int32_t t0r = (a[0] >> shift) + (c[0] >> shift), t0i = (a[1] >> shift) + (c[1] >> shift);
+            int32_t t1r = (a[0] >> shift) - (c[0] >> shift), t1i = (a[1] >> shift) - (c[1] >> shift);
+            int32_t t2r = (b[0] >> shift) + (d[0] >> shift), t2i = (b[1] >> shift) + (d[1] >> shift);
+            int32_t t3r = (b[0] >> shift) - (d[0] >> shift), t3i = (b[1] >> shift) - (d[1] >> shift);
+            int32_t y[4u][2u] =
+            {
+                { t0r + t2r, t0i + t2i },   /* a + b + c + d */
+                { t0r - t2r, t0i - t2i },   /* a - b + c - d, times W^2j */
+                { t1r + t3i, t1i - t3r },   /* a - jb - c + jd, times W^j */
+                { t1r - t3i, t1i + t3r },   /* a + jb - c - jd, times W^3j */
+            };
+
+            if(j != 0u)
+            {
+                twiddle(&y[1][0], &y[1][1], 2u * j * stride);
+                twiddle(&y[2][0], &y[2][1], j * stride);
+                twiddle(&y[3][0], &y[3][1], 3u * j * stride);
+            }
+            for(size_t slot = 0u; slot < 4u; slot++)
+            {
+                int16_t* out = a + (2u * slot * quarter);
+                int32_t largest = (magnitude(y[slot][0]) > magnitude(y[slot][1])) ? magnitude(y[slot][0]) : magnitude(y[slot][1]);
+
+                out[0] = (int16_t)y[slot][0];
+                out[1] = (int16_t)y[slot][1];
+                slot_max[slot] = (largest > slot_max[slot]) ? largest : slot_max[slot];
+            }
+        }
+    }
+}
+
+/* The last stage when log2(points) is odd: length-2 groups, every twiddle is 1. */
+static int32_t radix2_stage(int16_t* data, size_t points, unsigned shift)
+{
+    int32_t max = 0;
+
+    for(size_t i = 0u; i < 4u * (points / 2u); i = i + 4u)
+    {
+        int32_t ar = data[i] >> shift, ai = data[i + 1u] >> shift;
+        int32_t br = data[i + 2u] >> shift, bi = data[i + 3u] >> shift;
+
+        data[i] = (int16_t)(ar + br);
+        data[i + 1u] = (int16_t)(ai + bi);
+        data[i + 2u] = (int16_t)(ar - br);
+        data[i + 3u] = (int16_t)(ai - bi);
+        max = (magnitude(ar + br) > max) ? magnitude(ar + br) : max;
+        max = (magnitude(ai + bi) > max) ? magnitude(ai + bi) : max;
+        max = (magnitude(ar - br) > max) ? magnitude(ar - br) : max;
+        max = (magnitude(ai - bi) > max) ? magnitude(ai - bi) : max;
+    }
+    return max;
+}
+
+static int32_t max_of(const int32_t* values)
+{
+    int32_t max = 0;
+
+    for(size_t i = 0u; i < 4u; i++)
+    {
+        max = (values[i] > max) ? values[i] : max;
+    }
+    return max;
+}
+
+/* Every stage of a points-long block, largest input component max. Returns the block's exponent. */
+static int transform_block(int16_t* data, size_t points, int32_t max)
+{
+    size_t length = points;
+    int exponent = 0;
+
+    for(; length >= 4u; length = length / 4u)
+    {
+        int32_t slot_max[4u] = { 0 };
+        unsigned shift = headroom_shift(max, RADIX4_LIMIT);
+
+        radix4_stage(data, points, length, shift, 0u, length / 4u, slot_max);
+        max = max_of(slot_max);
+        exponent = exponent + (int)shift;
+    }
+    if(length == 2u)
+    {
+        unsigned shift = headroom_shift(max, RADIX2_LIMIT);
+
+        radix2_stage(data, points, shift);
+        exponent = exponent + (int)shift;
+    }
+    return exponent;
+}
+
+static void transform_quarters(int16_t* data, size_t points, size_t first, const int32_t* quarter_max, int* exponents)
+{
+    size_t quarter = points / 4u;
+
+    for(size_t q = first; q < first + 2u; q++)
+    {
+        exponents[q] = transform_block(data + (2u * q * quarter), quarter, quarter_max[q]);
+    }
+}
+
+static void shift_block(int16_t* data, size_t points, unsigned shift)
+{
+    for(size_t i = 0u; (shift != 0u) && (i < 2u * points); i++)
+    {
+        data[i] = (int16_t)(data[i] >> shift);
+    }
+}
+
+static size_t reverse_bits(size_t index, size_t points)
+{
+    size_t reversed = 0u;
+
+    for(size_t bit = 1u; bit < points; bit = bit << 1u)
+    {
+        reversed = (reversed << 1u) | (index & 1u);
+        index = index >> 1u;
+    }
+    return reversed;
+}
+
+/* Aligns the quarters to the largest exponent and puts the bins in natural order. Returns the final exponent. */
+static int finish(int16_t* data, size_t points, unsigned first_shift, const int* exponents)
+{
+    size_t quarter = points / 4u;
+    int largest = exponents[0];
+
+    for(size_t q = 1u; q < 4u; q++)
+    {
+        largest = (exponents[q] > largest) ? exponents[q] : largest;
+    }
+    for(size_t q = 0u; q < 4u; q++)
+    {
+        shift_block(data + (2u * q * quarter), quarter, (unsigned)(largest - exponents[q]));
+    }
+    for(size_t i = 0u; i < points; i++)
+    {
+        size_t j = reverse_bits(i, points);
+
+        if(i < j)
+        {
+            uint32_t temp;
+
+            memcpy(&temp, &data[2u * i], sizeof(temp));
+            memcpy(&data[2u * i], &data[2u * j], sizeof(temp));
+            memcpy(&data[2u * j], &temp, sizeof(temp));
+        }
+    }
+    return (int)first_shift + largest;
+}
+
+int fft_complex(int16_t* data, size_t points)
+{
+    int32_t quarter_max[4u] = { 0 };
+    int exponents[4u];
+    unsigned shift = headroom_shift(block_max(data, points), RADIX4_LIMIT);
+
+    radix4_stage(data, points, points, shift, 0u, points / 4u, quarter_max);
+    transform_quarters(data, points, 0u, quarter_max, exponents);
+    transform_quarters(data, points, 2u, quarter_max, exponents);
+    return finish(data, points, shift, exponents);
+}
+
+int fft_complex_dual(int16_t* data, size_t points)
+{
+    int32_t quarter_max[4u] = { 0 };
+    int exponents[4u];
+    unsigned shift = headroom_shift(block_max(data, points), RADIX4_LIMIT);
+    size_t split = points / 8u;
+
+    work.data = data;
+    work.points = points;
+    work.shift = shift;
+    multicore_fifo_push_blocking(FFT_TOKEN_STAGE);
+    radix4_stage(data, points, points, shift, 0u, split, quarter_max);
+    while(multicore_fifo_pop_blocking() != FFT_TOKEN_DONE);
+    for(size_t q = 0u; q < 4u; q++)
+    {
+        quarter_max[q] = (work.quarter_max[q] > quarter_max[q]) ? work.quarter_max[q] : quarter_max[q];
+        work.quarter_max[q] = quarter_max[q];
+    }
+
+    multicore_fifo_push_blocking(FFT_TOKEN_QUARTERS);
+    transform_quarters(data, points, 0u, quarter_max, exponents);
+    while(multicore_fifo_pop_blocking() != FFT_TOKEN_DONE);
+    exponents[2] = work.exponents[0];
+    exponents[3] = work.exponents[1];
+    return finish(data, points, shift, exponents);
+}
+
+void fft_worker(void)
+{
+    uint32_t token;
+
+    while((token = multicore_fifo_pop_blocking()) != FFT_TOKEN_END)
+    {
+        int16_t* data = work.data;
+        size_t points = work.points;
+
+        if(token == FFT_TOKEN_STAGE)
+        {
+            int32_t slot_max[4u] = { 0 };
+
+            radix4_stage(data, points, points, work.shift, points / 8u, points / 4u, slot_max);
+            for(size_t q = 0u; q < 4u; q++)
+            {
+                work.quarter_max[q] = slot_max[q];
+            }
+        }
+        else
+        {
+            int32_t quarter_max[4u];
+            int exponents[4u];
+
+            for(size_t q = 0u; q < 4u; q++)
+            {
+                quarter_max[q] = work.quarter_max[q];
+            }
+            transform_quarters(data, points, 2u, quarter_max, exponents);
+            work.exponents[0] = exponents[2];
+            work.exponents[1] = exponents[3];
+        }
+        multicore_fifo_push_blocking(FFT_TOKEN_DONE);
+    }
+}
+
+void fft_stop(void)
+{
+    multicore_fifo_push_blocking(FFT_TOKEN_END);
+}
+
+/* Splits the half-size complex spectrum Z of the even and odd samples into the real spectrum:
+ * X[k] = E + W^k O and X[M - k] = conj(E - W^k O), E = (Z[k] + conj Z[M - k]) / 2, O = -j (Z[k] - conj Z[M - k]) / 2. */
+int fft_real(int16_t* data, size_t points)
+{
+    size_t half = points / 2u;
+    size_t stride = FFT_MAX_POINTS / points;
+    int exponent = fft_complex(data, half);
+    unsigned shift = headroom_shift(block_max(data, half), REAL_SPLIT_LIMIT);
+    int32_t z0r = data[0], z0i = data[1];
+
+    data[0] = (int16_t)((z0r + z0i) >> shift);
+    data[1] = (int16_t)((z0r - z0i) >> shift);
+    for(size_t k = 1u; k <= half / 2u; k++)
+    {
+        int16_t* zk = &data[2u * k];
+        int16_t* zm = &data[2u * (half - k)];
+        int32_t er = (zk[0] + zm[0]) >> 1, ei = (zk[1] - zm[1]) >> 1;
+        int32_t orr = (zk[1] + zm[1]) >> 1, oi = (zm[0] - zk[0]) >> 1;
+
+        twiddle(&orr, &oi, k * stride);
+        zk[0] = (int16_t)((er + orr) >> shift);
+        zk[1] = (int16_t)((ei + oi) >> shift);
+        if(zm != zk)
+        {
+            zm[0] = (int16_t)((er - orr) >> shift);
+            zm[1] = (int16_t)((oi - ei) >> shift);
+        }
+    }
+    return exponent + (int)shift;
+}
+
+size_t fft_butterflies(size_t points)
+{
+    size_t butterflies = 0u;
+    size_t length = points;
+
+    for(; length >= 4u; length = length / 4u)
+    {
+        butterflies = butterflies + (points / 4u);
+    }
+    return (length == 2u) ? (butterflies + (points / 2u)) : butterflies;
+}
@@ -0,0 +1,38 @@
+#ifndef         _FFT_H
+#define         _FFT_H
+
+#include        <stddef.h>
+#include        <stdint.h>
+
+/* In-place Q15 forward FFT on interleaved re, im int16 pairs, 64 to FFT_MAX_POINTS points, powers of two.
+ * Radix-4 decimation in frequency with a radix-2 last stage when log2(points) is odd; outputs y1 and y2 of each
+ * butterfly swap places, so the result comes out in plain bit-reversed order and a single reorder finishes it.
+ *
+ * Block floating point: before each stage the block is shifted down just enough that the stage can't overflow,
+ * and the shifts are returned as an exponent, the true spectrum being the output times 2^exponent.
+ *
+ * The first stage is one set of butterflies over the whole block; after it the four quarters are independent
+ * quarter-size transforms, each with its own exponent, aligned to the largest at the end. The two-core version
+ * splits the first stage's butterflies and then the quarters between the cores, so it matches the single-core
+ * result bit for bit. */
+#define         FFT_MIN_POINTS          64u
+#define         FFT_MAX_POINTS          4096u
+
+/* Fills the twiddle table, W^k for k below 3/4 of FFT_MAX_POINTS, in SRAM. Call once before any transform. */
+void fft_init(void);
+
+int fft_complex(int16_t* data, size_t points);
+
+/* points real samples in; out, packed: X[0].re, X[points / 2].re, then X[k].re, X[k].im for k = 1 to points / 2 - 1.
+ * Runs a points / 2 complex transform on the samples taken as pairs and splits it, same range of points. */
+int fft_real(int16_t* data, size_t points);
+
+/* Two-core complex transform. Core 1 must be inside fft_worker. */
+int fft_complex_dual(int16_t* data, size_t points);
+void fft_worker(void);
+void fft_stop(void);
+
+/* Radix-4 and radix-2 butterflies in one transform, for cycles-per-butterfly figures. */
+size_t fft_butterflies(size_t points);
+
+#endif
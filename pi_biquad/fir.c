@@ -0,0 +1,161 @@
+#include        <math.h>
+#include        <stdbool.h>
+#include        <stdint.h>
+#include        <string.h>
+
+#include        "fir.h"
+
+static int16_t fir_saturate_q15(int64_t accumulator)
+{
+    int64_t output = accumulator >> FIR_TAP_SHIFT;
+
+    if(output > INT16_MAX)
+    {
+        return INT16_MAX;
+    }
+    if(output < INT16_MIN)
+    {
+        return INT16_MIN;
+    }
+    return (int16_t)output;
+}
+
+/* window[k] is x[n - k]. Four taps per pass, each product still widened on its own. */
+static int64_t dot_direct(const int16_t* taps, const int16_t* window, size_t tap_count)
+{
+    int64_t accumulator = 0;
+    size_t k = 0u;
+
+    for(; (k + 4u) <= tap_count; k = k + 4u)
+    {
+        accumulator = accumulator + (int32_t)(taps[k] * window[k]);
+        accumulator = accumulator + (int32_t)(taps[k + 1u] * window[k + 1u]);
+        accumulator = accumulator + (int32_t)(taps[k + 2u] * window[k + 2u]);
+        accumulator = accumulator + (int32_t)(taps[k + 3u] * window[k + 3u]);
+    }
+    for(; k < tap_count; k++)
+    {
+        accumulator = accumulator + (int32_t)(taps[k] * window[k]);
+    }
+    return accumulator;
+}
+
+static int64_t dot_folded(const int16_t* taps, const int16_t* window, size_t tap_count)
+{
+    const int16_t* mirror = window + tap_count - 1u;
+    size_t half = tap_count / 2u;
+    int64_t accumulator = 0;
+    size_t k = 0u;
+
+    for(; (k + 4u) <= half; k = k + 4u)
+    {
+        accumulator = accumulator + (int32_t)(taps[k] * (window[k] + mirror[-(ptrdiff_t)k]));
+        accumulator = accumulator + (int32_t)(taps[k + 1u] * (window[k + 1u] + mirror[-(ptrdiff_t)k - 1]));
+        accumulator = accumulator + (int32_t)(taps[k + 2u] * (window[k + 2u] + mirror[-(ptrdiff_t)k - 2]));
+        accumulator = accumulator + (int32_t)(taps[k + 3u] * (window[k + 3u] + mirror[-(ptrdiff_t)k - 3]));
+    }
+    for(; k < half; k++)
+    {
+        accumulator = accumulator + (int32_t)(taps[k] * (window[k] + mirror[-(ptrdiff_t)k]));
+    }
+    if((tap_count % 2u) != 0u)
+    {
+        accumulator = accumulator + (int32_t)(taps[half] * window[half]);
+    }
+    return accumulator;
+}
+
+static bool taps_foldable(const int16_t* taps, size_t tap_count)
+{
+    for(size_t k = 0u; k < tap_count; k++)
+    {
+        if((taps[k] != taps[tap_count - 1u - k]) || (taps[k] == INT16_MIN))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void fir_init(fir_state* state, const int16_t* taps, size_t tap_count, bool fold)
+{
+    state->tap_count = (tap_count < FIR_MAX_TAPS) ? tap_count : FIR_MAX_TAPS;
+    memcpy(state->taps, taps, state->tap_count * sizeof(int16_t));
+    state->folded = fold && taps_foldable(state->taps, state->tap_count);
+    fir_reset(state);
+}
+
+void fir_reset(fir_state* state)
+{
+    memset(state->history, 0, sizeof(state->history));
+    state->position = 0u;
+    state->decimation_phase = 0u;
+}
+
+static inline void push_sample(fir_state* state, int16_t sample)
+{
+    state->position = (state->position == 0u) ? (state->tap_count - 1u) : (state->position - 1u);
+    state->history[state->position] = sample;
+    state->history[state->position + state->tap_count] = sample;
+}
+
+static inline int16_t current_output(const fir_state* state)
+{
+    const int16_t* window = &state->history[state->position];
+
+    return fir_saturate_q15(state->folded ? dot_folded(state->taps, window, state->tap_count)
+                                          : dot_direct(state->taps, window, state->tap_count));
+}
+
+void fir_process(fir_state* state, const int16_t* in, int16_t* out, size_t length)
+{
+    if(state->tap_count == 0u)
+    {
+        memset(out, 0, length * sizeof(int16_t));
+        return;
+    }
+    for(size_t i = 0u; i < length; i++)
+    {
+        push_sample(state, in[i]);
+        out[i] = current_output(state);
+    }
+}
+
+size_t fir_decimate(fir_state* state, size_t factor, const int16_t* in, int16_t* out, size_t length)
+{
+    size_t written = 0u;
+
+    if((state->tap_count == 0u) || (factor == 0u))
+    {
+        return 0u;
+    }
+    for(size_t i = 0u; i < length; i++)
+    {
+        push_sample(state, in[i]);
+        state->decimation_phase = state->decimation_phase + 1u;
+        if(state->decimation_phase == factor)
+        {
+            out[written] = current_output(state);
+            written = written + 1u;
+            state->decimation_phase = 0u;
+        }
+    }
+    return written;
+}
+
+void fir_design_lowpass(int16_t* taps, size_t tap_count, double cutoff)
+{
+    const double pi = 3.14159265358979323846;
+    double centre = (tap_count - 1u) / 2.0;
+
+    for(size_t k = 0u; k < (tap_count + 1u) / 2u; k++)
+    {
+        double t = k - centre;
+        double sinc = (t == 0.0) ? (2.0 * cutoff) : (sin(2.0 * pi * cutoff * t) / (pi * t));
+        double window = (tap_count > 1u) ? (0.54 - 0.46 * cos((2.0 * pi * k) / (tap_count - 1u))) : 1.0;
+        double scaled = floor(sinc * window * (double)(1u << FIR_TAP_SHIFT) + 0.5);
+
+        taps[k] = (int16_t)((scaled > INT16_MAX) ? INT16_MAX : ((scaled < -INT16_MAX) ? -INT16_MAX : scaled));
+        taps[tap_count - 1u - k] = taps[k];
+    }
+}
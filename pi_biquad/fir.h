@@ -0,0 +1,39 @@
+#ifndef         _FIR_H
+#define         _FIR_H
+
+#include        <stdbool.h>
+#include        <stddef.h>
+#include        <stdint.h>
+
+/* Q15 taps, int16 samples, 64-bit accumulator so 256 full-scale products can't overflow. */
+#define         FIR_MAX_TAPS            256u
+#define         FIR_TAP_SHIFT           15u
+
+/* The history holds every sample twice, tap_count apart, so the window for a dot product is always contiguous
+ * and the circular index is only touched once per input sample rather than once per tap. */
+typedef struct fir_state_s
+{
+    int16_t taps[FIR_MAX_TAPS];
+    int16_t history[2u * FIR_MAX_TAPS];
+    size_t tap_count;
+    size_t position;            /* index of the newest sample */
+    size_t decimation_phase;    /* inputs taken since the last kept output */
+    bool folded;                /* symmetric taps summed in pairs, one multiply per pair */
+} fir_state;
+
+/* tap_count is clamped to FIR_MAX_TAPS. Folding is used when fold is set and the taps are symmetric and above
+ * INT16_MIN, which keeps each folded product inside 32 bits. The result is bit-exact either way. */
+void fir_init(fir_state* state, const int16_t* taps, size_t tap_count, bool fold);
+void fir_reset(fir_state* state);
+
+/* One output per input. Feeding a stream in blocks gives the same output as one call. */
+void fir_process(fir_state* state, const int16_t* in, int16_t* out, size_t length);
+
+/* Decimate by factor: every input enters the history, but only each factor-th output is computed. The phase carries
+ * across calls. Returns the number of outputs written. */
+size_t fir_decimate(fir_state* state, size_t factor, const int16_t* in, int16_t* out, size_t length);
+
+/* Hamming-windowed sinc lowpass with exactly mirrored Q15 taps, cutoff as a fraction of the sample rate. */
+void fir_design_lowpass(int16_t* taps, size_t tap_count, double cutoff);
+
+#endif
@@ -0,0 +1,117 @@
+#include        <math.h>
+#include        <stdint.h>
+#include        <string.h>
+
+#include        "pico/multicore.h"
+
+#include        "goertzel.h"
+
+#define         GOERTZEL_TOKEN_RUN      0x60E27201u
+#define         GOERTZEL_TOKEN_DONE     0x60E27202u
+#define         GOERTZEL_TOKEN_END      0x60E27203u
+
+/* Core 1's bank and samples, published before the FIFO token that hands them over. */
+typedef struct goertzel_work_s
+{
+    goertzel_bank* bank;
+    const int16_t* in;
+    size_t length;
+} goertzel_work;
+
+static volatile goertzel_work work;
+
+/* coeff * s >> 14 without a 64-bit multiply: s splits into a high part and a 14-bit low part, both products fit. */
+static inline int32_t scale_q14(int32_t coeff, int32_t s)
+{
+    return (coeff * (s >> GOERTZEL_COEFF_SHIFT)) + ((coeff * (s & ((1 << GOERTZEL_COEFF_SHIFT) - 1))) >> GOERTZEL_COEFF_SHIFT);
+}
+
+void goertzel_init(goertzel_bank* bank, const double* frequencies, size_t bin_count, size_t block_length)
+{
+    const double pi = 3.14159265358979323846;
+    double peak_gain = 1.0;
+
+    memset(bank, 0, sizeof(*bank));
+    bank->bin_count = (bin_count < GOERTZEL_MAX_BINS) ? bin_count : GOERTZEL_MAX_BINS;
+    bank->block_length = block_length;
+    for(size_t bin = 0u; bin < bank->bin_count; bin++)
+    {
+        double omega = 2.0 * pi * frequencies[bin];
+        double gain = fabs(sin(omega)) > (1.0 / block_length) ? (1.0 / fabs(sin(omega))) : (double)block_length;
+
+        bank->bins[bin].coeff = (int32_t)floor(2.0 * cos(omega) * (double)(1u << GOERTZEL_COEFF_SHIFT) + 0.5);
+        peak_gain = (gain > peak_gain) ? gain : peak_gain;
+    }
+    /* s[n] sums x[m] sin((n - m + 1) w) / sin w, so |s| stays under block_length * min(block_length, 1 / sin w) * |x|.
+     * Keeping that under 2^28 leaves room for coeff * s1 and for the high half of scale_q14. */
+    while(((double)block_length * peak_gain * (double)(32768u >> bank->input_shift)) >= (double)(1u << 28u))
+    {
+        bank->input_shift = bank->input_shift + 1u;
+    }
+}
+
+void goertzel_reset(goertzel_bank* bank)
+{
+    for(size_t bin = 0u; bin < bank->bin_count; bin++)
+    {
+        bank->bins[bin].s1 = 0;
+        bank->bins[bin].s2 = 0;
+    }
+}
+
+void goertzel_process(goertzel_bank* bank, const int16_t* in, size_t length)
+{
+    goertzel_bin* bins = bank->bins;
+    size_t bin_count = bank->bin_count;
+    unsigned input_shift = bank->input_shift;
+
+    for(size_t i = 0u; i < length; i++)
+    {
+        int32_t sample = in[i] >> input_shift;
+
+        for(size_t bin = 0u; bin < bin_count; bin++)
+        {
+            int32_t s0 = sample + scale_q14(bins[bin].coeff, bins[bin].s1) - bins[bin].s2;
+
+            bins[bin].s2 = bins[bin].s1;
+            bins[bin].s1 = s0;
+        }
+    }
+}
+
+void goertzel_process_dual(goertzel_bank* own, goertzel_bank* other, const int16_t* in, size_t length)
+{
+    work.bank = other;
+    work.in = in;
+    work.length = length;
+    multicore_fifo_push_blocking(GOERTZEL_TOKEN_RUN);
+    goertzel_process(own, in, length);
+    while(multicore_fifo_pop_blocking() != GOERTZEL_TOKEN_DONE);
+}
+
+void goertzel_worker(void)
+{
+    while(multicore_fifo_pop_blocking() == GOERTZEL_TOKEN_RUN)
+    {
+        goertzel_process(work.bank, work.in, work.length);
+        multicore_fifo_push_blocking(GOERTZEL_TOKEN_DONE);
+    }
+}
+
+void goertzel_stop(void)
+{
+    multicore_fifo_push_blocking(GOERTZEL_TOKEN_END);
+}
+
+void goertzel_finish(goertzel_bank* bank, uint64_t* power)
+{
+    for(size_t bin = 0u; bin < bank->bin_count; bin++)
+    {
+        int64_t s1 = bank->bins[bin].s1;
+        int64_t s2 = bank->bins[bin].s2;
+        int64_t value = (s1 * s1) + (s2 * s2) - ((int64_t)scale_q14(bank->bins[bin].coeff, bank->bins[bin].s1) * s2);
+
+        power[bin] = (value > 0) ? (uint64_t)value : 0u;
+    }
+    goertzel_reset(bank);
+}
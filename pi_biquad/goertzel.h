@@ -0,0 +1,43 @@
+#ifndef         _GOERTZEL_H
+#define         _GOERTZEL_H
+
+#include        <stddef.h>
+#include        <stdint.h>
+
+/* A bank of Goertzel resonators over blocks of block_length samples. Every sample updates every bin in one pass
+ * over the block, so each sample is loaded once and the bin states sit side by side in memory. */
+#define         GOERTZEL_MAX_BINS       64u
+#define         GOERTZEL_COEFF_SHIFT    14u
+
+typedef struct goertzel_bin_s
+{
+    int32_t coeff;              /* 2 cos(2 pi f), Q14 */
+    int32_t s1;
+    int32_t s2;
+} goertzel_bin;
+
+typedef struct goertzel_bank_s
+{
+    goertzel_bin bins[GOERTZEL_MAX_BINS];
+    size_t bin_count;
+    size_t block_length;
+    unsigned input_shift;       /* keeps the resonators inside 31 bits over a whole block */
+} goertzel_bank;
+
+/* frequencies are fractions of the sample rate, 0 to 0.5. bin_count is clamped to GOERTZEL_MAX_BINS. */
+void goertzel_init(goertzel_bank* bank, const double* frequencies, size_t bin_count, size_t block_length);
+void goertzel_reset(goertzel_bank* bank);
+
+/* Feeds the next length samples of the current block; a block may arrive in any number of parts. */
+void goertzel_process(goertzel_bank* bank, const int16_t* in, size_t length);
+
+/* Two cores over the same samples, core 0 updating own and core 1 other, typically the two halves of one bank.
+ * Core 1 must be inside goertzel_worker. */
+void goertzel_process_dual(goertzel_bank* own, goertzel_bank* other, const int16_t* in, size_t length);
+void goertzel_worker(void);
+void goertzel_stop(void);
+
+/* Ends the block: |X|^2 per bin in units of (sample >> input_shift)^2, then zeroes the resonators. */
+void goertzel_finish(goertzel_bank* bank, uint64_t* power);
+
+#endif
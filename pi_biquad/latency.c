@@ -0,0 +1,41 @@
+#include        <stdint.h>
+#include        <string.h>
+
+#include        "latency.h"
+
+void latency_reset(latency_histogram* histogram)
+{
+    memset(histogram, 0, sizeof(*histogram));
+}
+
+/* First value of the bucket after this one, i.e. this bucket's exclusive upper edge. */
+static uint32_t bucket_limit(uint32_t bucket)
+{
+    uint32_t next = bucket + 1u;
+
+    if(next < LATENCY_SUB_BUCKETS)
+    {
+        return next;
+    }
+    return (LATENCY_SUB_BUCKETS + (next % LATENCY_SUB_BUCKETS)) << ((next / LATENCY_SUB_BUCKETS) - 1u);
+}
+
+uint32_t latency_percentile(const latency_histogram* histogram, uint32_t percent)
+{
+    /* Rank of the sample the percentile falls on, counting from 1. */
+    uint64_t rank = (((uint64_t)histogram->count * percent) + 99u) / 100u;
+    uint64_t seen = 0u;
+
+    rank = (rank == 0u) ? 1u : rank;
+    for(uint32_t bucket = 0u; bucket < LATENCY_BUCKETS; bucket++)
+    {
+        seen = seen + histogram->buckets[bucket];
+        if(seen >= rank)
+        {
+            uint32_t upper = bucket_limit(bucket) - 1u;
+
+            return (upper < histogram->max_us) ? upper : histogram->max_us;
+        }
+    }
+    return histogram->max_us;
+}
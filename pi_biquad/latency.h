@@ -0,0 +1,45 @@
+#ifndef         _LATENCY_H
+#define         _LATENCY_H
+
+#include        <stdint.h>
+
+/* Per-core latency histogram. Each core records only into its own, so recording needs no locks; read it once the
+ * run is over. Buckets are exact below 8 microseconds, then eight to each power of two, so any value is within
+ * 12.5% of its bucket. */
+#define         LATENCY_SUB_BUCKETS     8u
+#define         LATENCY_BUCKETS         128u    /* up to about a quarter of a second, longer waits land in the last */
+
+typedef struct latency_histogram_s
+{
+    uint32_t buckets[LATENCY_BUCKETS];
+    uint32_t count;
+    uint32_t max_us;
+} latency_histogram;
+
+static inline uint32_t latency_bucket(uint32_t us)
+{
+    uint32_t msb;
+    uint32_t bucket;
+
+    if(us < LATENCY_SUB_BUCKETS)
+    {
+        return us;
+    }
+    msb = 31u - (uint32_t)__builtin_clz(us);
+    bucket = ((msb - 2u) * LATENCY_SUB_BUCKETS) + ((us >> (msb - 3u)) & (LATENCY_SUB_BUCKETS - 1u));
+    return (bucket < LATENCY_BUCKETS) ? bucket : (LATENCY_BUCKETS - 1u);
+}
+
+static inline void latency_record(latency_histogram* histogram, uint32_t us)
+{
+    histogram->buckets[latency_bucket(us)]++;
+    histogram->count = histogram->count + 1u;
+    histogram->max_us = (us > histogram->max_us) ? us : histogram->max_us;
+}
+
+void latency_reset(latency_histogram* histogram);
+
+/* Upper edge of the bucket holding the given percentile, capped at the largest value recorded. 0 when empty. */
+uint32_t latency_percentile(const latency_histogram* histogram, uint32_t percent);
+
+#endif
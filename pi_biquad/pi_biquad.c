@@ -1,5 +1,7 @@
+#include        <math.h>
 #include        <stdint.h>
 #include        <stdio.h>
+#include        <stdlib.h>
 #include        <string.h>
 
 #include        "hardware/vreg.h"
@@ -9,47 +11,1457 @@
 #include        "pico/time.h"
 #include        "pico/types.h"
 
-#define         LED_PIN         PICO_DEFAULT_LED_PIN
-#define         ARRAY_SIZE      32768U
-#define         ITERATIONS      4096U
+#include        "bench.h"
+#include        "biquad.h"
+#include        "biquad_asm.h"
+#include        "biquad_design.h"
+#include        "biquad_eq.h"
+#include        "biquad_lookahead.h"
+#include        "biquad_multichannel.h"
+#include        "biquad_precision.h"
+#include        "biquad_swar.h"
+#include        "fft.h"
+#include        "fir.h"
+#include        "goertzel.h"
+#include        "latency.h"
+#include        "realtime.h"
+#include        "sample_source.h"
+#include        "signal.h"
+#include        "verify.h"
 
-const int16_t a0 = 16384;
-const int16_t a1 = -32768;
-const int16_t a2 = 16384;
-const int16_t b1 = -25576;
-const int16_t b2 = 10508;
+#define         LED_PIN             PICO_DEFAULT_LED_PIN
+#define         ARRAY_SIZE          16384U  /* four of these per program, in striped SRAM0-3 */
+#define         ITERATIONS          128U
+#define         SWEEP_SECTIONS      4U
+#define         MIN_BLOCK_SIZE      16U
+#define         PEAK_PERCENT        95U
+#define         LAYOUT_SECTIONS     2U
+#define         MIN_CHANNELS        2U
+#define         SWAR_FRAMES         2048U   /* packed stereo frames per core, in and out */
+#define         ERROR_SAMPLES       4096U
+#define         RETUNE_COUNT        16U
+#define         PRECISION_ITERATIONS    4U      /* soft double manages well under 100 kiloSamples per second on the board */
+#define         VERIFY_RETRY_MS     5000U   /* between golden checks once one has failed */
 
-void core1_main(void)
+#define         REALTIME_RATE       96000U
+#define         REALTIME_BLOCK      64U
+#define         REALTIME_BLOCKS     1500U   /* one second at REALTIME_RATE */
+#define         REALTIME_MIN_RATE   8000U
+#define         REALTIME_MAX_RATE   16000000U
+
+#define         LIVE_RATE           500000U
+#define         LIVE_BLOCK          256U
+#define         LIVE_BLOCKS         1000U   /* about half a second at LIVE_RATE */
+#define         LIVE_INPUTS         0x1U    /* ADC0 on GPIO26 */
+#define         LIVE_PATH_ENV       "PI_BIQUAD_SOURCE"  /* host: file to stream, unset plays a chirp */
+
+#define         PLACEMENT_BLOCK     256U    /* in + out per core, leaving the rest of the 4 KB bank to the core's stack */
+#define         PLACEMENT_ITERATIONS    8192U
+
+#define         PIPELINE_SECTIONS   8U
+#define         PIPELINE_SPLIT      (PIPELINE_SECTIONS / 2U)
+#define         PIPELINE_BLOCK      256U
+#define         PIPELINE_SLOTS      4U      /* at most the 8 words of one FIFO direction */
+#define         PIPELINE_END        0xFFFFFFFFu
+
+#define         LATENCY_RATE        96000U
+#define         LATENCY_MIN_BLOCK   16U     /* up to PIPELINE_BLOCK, doubling */
+#define         LATENCY_RUN_MS      250U    /* per block size and configuration */
+
+#define         FIR_MIN_TAPS        8U
+#define         FIR_DECIMATION      4U
+#define         FIR_CUTOFF          0.1     /* below the decimated Nyquist of 0.125 */
+#define         FIR_MAC_BUDGET      8000000U    /* per mode and tap count, about a second on the board */
+
+#define         FFT_CHECK_POINTS    1024U   /* largest size checked against the double reference */
+#define         FFT_BUTTERFLY_BUDGET    2000000U    /* per size and mode */
+
+#define         GOERTZEL_BLOCK      1024U
+#define         GOERTZEL_BLOCKS     64U     /* blocks timed per bank size */
+#define         GOERTZEL_RANGE_DB   40.0    /* bins this far below the strongest are left out of the accuracy check */
+
+#define         EQ_BANDS            8U
+#define         EQ_SETS             16U     /* precomputed settings the retuning cycles through */
+#define         EQ_BLOCK            64U
+#define         EQ_BLOCKS           16384U  /* a million samples per run */
+
+#define         LOOKAHEAD_SECTIONS  4U
+#define         LOOKAHEAD_BLOCK     4096U   /* long enough that the fix-up is a small part of each half */
+
+/* The original hardcoded section: the cookbook highpass at fs/20, Q 0.7071, with its (1, -2, 1) numerator left unnormalised. */
+static const biquad_coeffs highpass_coeffs = { .a0 = 16384, .a1 = -32768, .a2 = 16384, .b1 = -25576, .b2 = 10508 };
+static biquad_coeffs cascade_coeffs[BIQUAD_MAX_SECTIONS];
+
+/* Main working buffers, one pair per core, in static striped SRAM rather than on the small core stacks. */
+static int16_t core0_in[ARRAY_SIZE];
+static int16_t core0_out[ARRAY_SIZE];
+static int16_t core1_in[ARRAY_SIZE];
+static int16_t core1_out[ARRAY_SIZE];
+
+/* Small working sets for the placement benchmark. The SDK puts core 0's stack in SRAM5 (scratch Y) and core 1's
+ * in SRAM4 (scratch X), so each core's scratch block shares a bank only with its own stack. */
+static int16_t core0_striped_block[2u][PLACEMENT_BLOCK];
+static int16_t core1_striped_block[2u][PLACEMENT_BLOCK];
+static int16_t __scratch_y("pi_biquad") core0_scratch_block[2u][PLACEMENT_BLOCK];
+static int16_t __scratch_x("pi_biquad") core1_scratch_block[2u][PLACEMENT_BLOCK];
+
+typedef enum placement_e
+{
+    PLACEMENT_STRIPED = 0,
+    PLACEMENT_SCRATCH
+} placement;
+
+static placement core_placement[2u];
+static uint64_t placement_rates[2u];
+
+/* Working sets of benchmarks that never run at the same time share one region. Side by side they would not fit in
+ * striped SRAM next to the main buffers and the SDK's own data. */
+static union
+{
+    struct
+    {
+        uint32_t in[2u][SWAR_FRAMES];
+        uint32_t out[2u][SWAR_FRAMES];
+    } swar;                                             /* both cores at once, each on its own half */
+    double fft_reference[2u * FFT_CHECK_POINTS];        /* core 0 only */
+    int16_t lookahead[LOOKAHEAD_BLOCK];                 /* core 0 only */
+} bench_scratch;
+
+static biquad_state pipeline_stages[2u];
+static int16_t pipeline_slots[PIPELINE_SLOTS][PIPELINE_BLOCK];
+static volatile uint64_t pipeline_stage2_busy_us;
+
+static latency_histogram latency_histograms[2u];
+static absolute_time_t latency_ingress[PIPELINE_SLOTS];
+static volatile size_t latency_block_length;
+
+static fir_state fir_states[2u];
+static int16_t fir_taps[2u][FIR_MAX_TAPS];
+
+
+static goertzel_bank goertzel_banks[2u];
+static int16_t goertzel_input[GOERTZEL_BLOCK];
+static double goertzel_frequencies[GOERTZEL_MAX_BINS];
+static uint64_t goertzel_power[GOERTZEL_MAX_BINS];
+static volatile uint64_t goertzel_sink;
+
+static biquad_eq eq;
+static biquad_coeffs eq_sets[EQ_SETS][EQ_BANDS];
+static volatile bool eq_done;
+static volatile uint64_t eq_core1_us;
+static volatile uint32_t eq_torn_sets;
+
+static biquad_lookahead lookahead_state;
+
+void biquad_benchmark(int16_t* in, int16_t* out, size_t buffer_length, size_t iteration_count, int core_number)
+{
+    biquad_state state;
+    absolute_time_t start_time;
+    uint64_t duration_us;
+    size_t samples = buffer_length * iteration_count;
+
+    for(size_t section_count = 1u; section_count <= BIQUAD_MAX_SECTIONS; section_count++)
+    {
+        biquad_state_init(&state, cascade_coeffs, section_count);
+
+        start_time = get_absolute_time();
+        for(size_t loop_var = 0u; loop_var < iteration_count; loop_var++)
+        {
+            biquad_process_block(&state, in, out, buffer_length);
+        }
+        duration_us = bench_elapsed_us(start_time);
+
+        printf("[Core #%d] %zu sections: finished %zu samples in %llu milliseconds.\n", core_number, section_count, samples, duration_us / 1000u);
+        printf("[Core #%d] %zu sections: %llu kiloSamples per second, %llu section-kiloSamples per second.\n", core_number, section_count,
+               bench_kilo_per_second(samples, duration_us), bench_kilo_per_second((uint64_t)samples * section_count, duration_us));
+    }
+}
+
+/* Streams the buffer through one cascade in blocks from MIN_BLOCK_SIZE up to the whole buffer. */
+void biquad_block_size_benchmark(int16_t* in, int16_t* out, size_t buffer_length, size_t iteration_count, int core_number)
+{
+    biquad_state state;
+    absolute_time_t start_time;
+    uint64_t rates[32u];
+    size_t sweep_count = 0u;
+    uint64_t peak_rate = 0u;
+    size_t samples = buffer_length * iteration_count;
+
+    biquad_state_init(&state, cascade_coeffs, SWEEP_SECTIONS);
+    for(size_t block_size = MIN_BLOCK_SIZE; block_size <= buffer_length; block_size = block_size * 2u)
+    {
+        start_time = get_absolute_time();
+        for(size_t loop_var = 0u; loop_var < iteration_count; loop_var++)
+        {
+            for(size_t offset = 0u; offset < buffer_length; offset = offset + block_size)
+            {
+                biquad_process_block(&state, in + offset, out + offset, block_size);
+            }
+        }
+        rates[sweep_count] = bench_kilo_per_second(samples, bench_elapsed_us(start_time));
+        peak_rate = (rates[sweep_count] > peak_rate) ? rates[sweep_count] : peak_rate;
+        printf("[Core #%d] %zu-sample blocks: %llu kiloSamples per second.\n", core_number, block_size, rates[sweep_count]);
+        sweep_count = sweep_count + 1u;
+    }
+
+    for(size_t i = 0u; i < sweep_count; i++)
+    {
+        if(rates[i] * 100u >= peak_rate * PEAK_PERCENT)
+        {
+            printf("[Core #%d] Smallest block within %u%% of peak: %zu samples.\n", core_number, PEAK_PERCENT, (size_t)MIN_BLOCK_SIZE << i);
+            break;
+        }
+    }
+}
+
+/* Same filter on 2 to 8 channels, once with interleaved frames and once with one plane per channel. */
+void biquad_layout_benchmark(int16_t* in, int16_t* out, size_t buffer_length, size_t iteration_count, int core_number)
+{
+    biquad_multichannel state;
+    const int16_t* in_planes[BIQUAD_MAX_CHANNELS];
+    int16_t* out_planes[BIQUAD_MAX_CHANNELS];
+    absolute_time_t start_time;
+    uint64_t interleaved_rate, planar_rate;
+
+    for(size_t channel_count = MIN_CHANNELS; channel_count <= BIQUAD_MAX_CHANNELS; channel_count++)
+    {
+        size_t frames = buffer_length / channel_count;
+        uint64_t samples = (uint64_t)frames * channel_count * iteration_count;
+
+        biquad_multichannel_init(&state, cascade_coeffs, LAYOUT_SECTIONS, channel_count);
+        start_time = get_absolute_time();
+        for(size_t loop_var = 0u; loop_var < iteration_count; loop_var++)
+        {
+            biquad_process_interleaved(&state, in, out, frames);
+        }
+        interleaved_rate = bench_kilo_per_second(samples, bench_elapsed_us(start_time));
+
+        for(size_t channel = 0u; channel < channel_count; channel++)
+        {
+            in_planes[channel] = in + (channel * frames);
+            out_planes[channel] = out + (channel * frames);
+        }
+        biquad_multichannel_reset(&state);
+        start_time = get_absolute_time();
+        for(size_t loop_var = 0u; loop_var < iteration_count; loop_var++)
+        {
+            biquad_process_planar(&state, in_planes, out_planes, frames);
+        }
+        planar_rate = bench_kilo_per_second(samples, bench_elapsed_us(start_time));
+
+        printf("[Core #%d] %zu channels: interleaved %llu, planar %llu kiloSamples per second.\n", core_number, channel_count,
+               interleaved_rate, planar_rate);
+    }
+}
+
+/* Two channels as packed words against two mono cascades over the same samples, counting both channels' samples. */
+void biquad_swar_benchmark(int16_t* in, int16_t* out, size_t buffer_length, size_t iteration_count, int core_number)
+{
+    biquad_state mono_states[2u];
+    biquad_swar_section sections[LAYOUT_SECTIONS];
+    absolute_time_t start_time;
+    size_t frames = ((buffer_length / 2u) < SWAR_FRAMES) ? (buffer_length / 2u) : SWAR_FRAMES;
+    uint64_t samples = (uint64_t)frames * 2u * iteration_count;
+    uint64_t mono_us, swar_us;
+
+    for(size_t i = 0u; i < frames; i++)
+    {
+        bench_scratch.swar.in[core_number][i] = biquad_swar_pack(in[i], in[frames + i]);
+    }
+
+    biquad_state_init(&mono_states[0], cascade_coeffs, LAYOUT_SECTIONS);
+    biquad_state_init(&mono_states[1], cascade_coeffs, LAYOUT_SECTIONS);
+    start_time = get_absolute_time();
+    for(size_t loop_var = 0u; loop_var < iteration_count; loop_var++)
+    {
+        biquad_process_block(&mono_states[0], in, out, frames);
+        biquad_process_block(&mono_states[1], in + frames, out + frames, frames);
+    }
+    mono_us = bench_elapsed_us(start_time);
+
+    for(size_t section = 0u; section < LAYOUT_SECTIONS; section++)
+    {
+        biquad_swar_init(&sections[section], &cascade_coeffs[section]);
+    }
+    start_time = get_absolute_time();
+    for(size_t loop_var = 0u; loop_var < iteration_count; loop_var++)
+    {
+        biquad_swar_process(sections, LAYOUT_SECTIONS, bench_scratch.swar.in[core_number], bench_scratch.swar.out[core_number], frames);
+    }
+    swar_us = bench_elapsed_us(start_time);
+
+#if BIQUAD_TOPOLOGY != BIQUAD_TOPOLOGY_DF2
+    /* Both ran the same input the same number of times from zeroed state, so the last pass must agree sample for sample.
+     * The packed sections are DF1, so that only holds while the mono cascade is DF1 or TDF2. */
+    size_t mismatches = 0u;
+
+    for(size_t i = 0u; i < frames; i++)
+    {
+        uint32_t packed = bench_scratch.swar.out[core_number][i];
+
+        if((biquad_swar_left(packed) != out[i]) || (biquad_swar_right(packed) != out[frames + i]))
+        {
+            mismatches = mismatches + 1u;
+        }
+    }
+    if(mismatches != 0u)
+    {
+        printf("[Core #%d] ERROR! Packed stereo differs from the mono passes in %zu frames.\n", core_number, mismatches);
+    }
+#endif
+    printf("[Core #%d] Stereo, %u sections: two mono passes %llu, packed %llu kiloSamples per second, %llu.%02llux.\n", core_number,
+           LAYOUT_SECTIONS, bench_kilo_per_second(samples, mono_us), bench_kilo_per_second(samples, swar_us), mono_us / swar_us,
+           (mono_us * 100u / swar_us) % 100u);
+}
+
+static uint64_t tenths_per_us(uint64_t count, uint64_t duration_us)
+{
+    return (count * 10u) / duration_us;
+}
+
+/* Windowed-sinc lowpass from FIR_MIN_TAPS to FIR_MAX_TAPS taps: plain and folded dot products, then decimation.
+ * MACs count every tap of every computed output, folded or not, so the modes compare on the same work. */
+void fir_benchmark(int16_t* in, int16_t* out, size_t buffer_length, int core_number)
+{
+    fir_state* state = &fir_states[core_number];
+    int16_t* taps = fir_taps[core_number];
+    absolute_time_t start_time;
+
+    for(size_t tap_count = FIR_MIN_TAPS; tap_count <= FIR_MAX_TAPS; tap_count = tap_count * 2u)
+    {
+        size_t iteration_count = FIR_MAC_BUDGET / (tap_count * buffer_length);
+        uint64_t samples, macs, direct_us, folded_us, decimate_us;
+        uint32_t expected_crc = 0u, decimated_crc = 0u;
+        size_t decimated = 0u;
+
+        iteration_count = (iteration_count == 0u) ? 1u : iteration_count;
+        samples = (uint64_t)buffer_length * iteration_count;
+        macs = samples * tap_count;
+        fir_design_lowpass(taps, tap_count, FIR_CUTOFF);
+
+        fir_init(state, taps, tap_count, false);
+        start_time = get_absolute_time();
+        for(size_t loop_var = 0u; loop_var < iteration_count; loop_var++)
+        {
+            fir_process(state, in, out, buffer_length);
+        }
+        direct_us = bench_elapsed_us(start_time);
+        expected_crc = verify_crc32(out, buffer_length, 0u);
+
+        fir_init(state, taps, tap_count, true);
+        start_time = get_absolute_time();
+        for(size_t loop_var = 0u; loop_var < iteration_count; loop_var++)
+        {
+            fir_process(state, in, out, buffer_length);
+        }
+        folded_us = bench_elapsed_us(start_time);
+        if(verify_crc32(out, buffer_length, 0u) != expected_crc)
+        {
+            printf("[Core #%d] ERROR! %zu taps: folded output differs from the direct form.\n", core_number, tap_count);
+        }
+
+        /* The kept outputs are every FIR_DECIMATION-th full-rate one, the buffer being a whole number of phases. */
+        expected_crc = 0u;
+        for(size_t i = FIR_DECIMATION - 1u; i < buffer_length; i = i + FIR_DECIMATION)
+        {
+            expected_crc = verify_crc32(&out[i], 1u, expected_crc);
+        }
+        fir_init(state, taps, tap_count, true);
+        start_time = get_absolute_time();
+        for(size_t loop_var = 0u; loop_var < iteration_count; loop_var++)
+        {
+            decimated = fir_decimate(state, FIR_DECIMATION, in, out, buffer_length);
+        }
+        decimate_us = bench_elapsed_us(start_time);
+        decimated_crc = verify_crc32(out, decimated, 0u);
+        if(decimated_crc != expected_crc)
+        {
+            printf("[Core #%d] ERROR! %zu taps: decimated crc32 0x%08lx - should be 0x%08lx.\n", core_number, tap_count,
+                   (unsigned long)decimated_crc, (unsigned long)expected_crc);
+        }
+
+        printf("[Core #%d] FIR %zu taps: direct %llu.%llu, folded %llu.%llu MMACs per second, %llu kiloSamples per second out folded.\n",
+               core_number, tap_count, tenths_per_us(macs, direct_us) / 10u, tenths_per_us(macs, direct_us) % 10u,
+               tenths_per_us(macs, folded_us) / 10u, tenths_per_us(macs, folded_us) % 10u, bench_kilo_per_second(samples, folded_us));
+        printf("[Core #%d] FIR %zu taps, decimate by %u: %llu.%llu MMACs per second, %llu kiloSamples per second out, %llu in.\n",
+               core_number, tap_count, FIR_DECIMATION, tenths_per_us(macs / FIR_DECIMATION, decimate_us) / 10u,
+               tenths_per_us(macs / FIR_DECIMATION, decimate_us) % 10u, bench_kilo_per_second(samples / FIR_DECIMATION, decimate_us),
+               bench_kilo_per_second(samples, decimate_us));
+    }
+}
+
+typedef struct topology_kernel_s
+{
+    const char* name;
+    void (*process)(const biquad_coeffs* coeffs, int32_t* state, const int16_t* in, int16_t* out, size_t length);
+} topology_kernel;
+
+static const topology_kernel topology_kernels[] =
+{
+    { "DF1",  biquad_df1_process },
+    { "DF2",  biquad_df2_process },
+    { "TDF2", biquad_tdf2_process },
+};
+
+typedef struct filter_error_s
+{
+    double mean;
+    double max;
+    double snr_db;
+} filter_error;
+
+/* Compares out against an ideal section in double precision with the same quantised coefficients, clipped to the int16 range. */
+static filter_error reference_error(const biquad_coeffs* coeffs, const int16_t* in, const int16_t* out, size_t length)
+{
+    const double scale = 1.0 / (double)(1u << BIQUAD_COEFF_SHIFT);
+    double x1 = 0.0, x2 = 0.0, y1 = 0.0, y2 = 0.0;
+    double error_sum = 0.0, signal_power = 0.0, noise_power = 0.0;
+    filter_error result = { 0 };
+
+    for(size_t i = 0u; i < length; i++)
+    {
+        double inTemp = in[i];
+        double outTemp = (coeffs->a0 * inTemp + coeffs->a1 * x1 + coeffs->a2 * x2 - coeffs->b1 * y1 - coeffs->b2 * y2) * scale;
+        double clipped = (outTemp > INT16_MAX) ? INT16_MAX : ((outTemp < INT16_MIN) ? INT16_MIN : outTemp);
+        double error = (out[i] > clipped) ? (out[i] - clipped) : (clipped - out[i]);
+
+        error_sum = error_sum + error;
+        signal_power = signal_power + clipped * clipped;
+        noise_power = noise_power + error * error;
+        result.max = (error > result.max) ? error : result.max;
+        x2 = x1;
+        x1 = inTemp;
+        y2 = y1;
+        y1 = outTemp;
+    }
+    result.mean = error_sum / length;
+    result.snr_db = (noise_power > 0.0) ? 10.0 * log10(signal_power / noise_power) : INFINITY;
+    return result;
+}
+
+/* Each topology filters the same input through one section; the kernel is picked per run, never per sample. */
+void biquad_topology_benchmark(int16_t* in, int16_t* out, size_t buffer_length, size_t iteration_count, int core_number)
+{
+    absolute_time_t start_time;
+    uint64_t samples = (uint64_t)buffer_length * iteration_count;
+    size_t error_length = (buffer_length < ERROR_SAMPLES) ? buffer_length : ERROR_SAMPLES;
+
+    for(size_t kernel = 0u; kernel < (sizeof(topology_kernels) / sizeof(topology_kernels[0])); kernel++)
+    {
+        int32_t state[BIQUAD_STATE_WORDS] = { 0 };
+        filter_error error;
+        uint64_t rate;
+
+        topology_kernels[kernel].process(&highpass_coeffs, state, in, out, error_length);
+        error = reference_error(&highpass_coeffs, in, out, error_length);
+
+        start_time = get_absolute_time();
+        for(size_t loop_var = 0u; loop_var < iteration_count; loop_var++)
+        {
+            topology_kernels[kernel].process(&highpass_coeffs, state, in, out, buffer_length);
+        }
+        rate = bench_kilo_per_second(samples, bench_elapsed_us(start_time));
+
+        printf("[Core #%d] %s: %llu kiloSamples per second, error against double reference: mean %.2f LSB, max %.0f LSB.\n", core_number,
+               topology_kernels[kernel].name, rate, error.mean, error.max);
+    }
+}
+
+static uint64_t tenths_of_cycles_per_sample(uint64_t samples, uint64_t duration_us)
+{
+    return ((uint64_t)(clock_get_hz(clk_sys) / 100000u) * duration_us) / samples;
+}
+
+/* The Thumb-1 kernel against its C reference on one section. The signatures of both outputs and final states must match. */
+void biquad_asm_benchmark(int16_t* in, int16_t* out, size_t buffer_length, size_t iteration_count, int core_number)
+{
+    static const char* const kernel_names[] = { "C DF1", "Thumb-1 DF1" };
+    absolute_time_t start_time;
+    uint64_t samples = (uint64_t)buffer_length * iteration_count;
+    uint32_t signatures[2u];
+
+    for(size_t kernel = 0u; kernel < 2u; kernel++)
+    {
+        int32_t state[BIQUAD_STATE_WORDS] = { 0 };
+        uint64_t duration_us;
+
+        start_time = get_absolute_time();
+        for(size_t loop_var = 0u; loop_var < iteration_count; loop_var++)
+        {
+            if(kernel == 0u)
+            {
+                biquad_df1_process(&highpass_coeffs, state, in, out, buffer_length);
+            }
+            else
+            {
+                biquad_asm_process(&highpass_coeffs, state, in, out, buffer_length);
+            }
+        }
+        duration_us = bench_elapsed_us(start_time);
+        signatures[kernel] = verify_crc32(out, buffer_length, 0u);
+        signatures[kernel] = verify_crc32((const int16_t*)state, (BIQUAD_STATE_WORDS * sizeof(int32_t)) / sizeof(int16_t), signatures[kernel]);
+
+        printf("[Core #%d] %s: %llu kiloSamples per second, %llu.%llu cycles per sample.\n", core_number, kernel_names[kernel],
+               bench_kilo_per_second(samples, duration_us), tenths_of_cycles_per_sample(samples, duration_us) / 10u,
+               tenths_of_cycles_per_sample(samples, duration_us) % 10u);
+    }
+    if(signatures[0] != signatures[1])
+    {
+        printf("[Core #%d] ERROR! Thumb-1 DF1 crc32 0x%08lx - should be 0x%08lx.\n", core_number, (unsigned long)signatures[1],
+               (unsigned long)signatures[0]);
+    }
+}
+
+/* Same section and input in Q14, Q31, ROM float and soft double, side by side. */
+void biquad_precision_benchmark(int16_t* in, int16_t* out, size_t buffer_length, size_t iteration_count, int core_number)
+{
+    static const char* const mode_names[] = { "Q14 (32-bit accumulator)", "Q31 (64-bit accumulator)", "float (ROM)", "double (soft)" };
+    uint64_t samples = (uint64_t)buffer_length * iteration_count;
+    size_t error_length = (buffer_length < ERROR_SAMPLES) ? buffer_length : ERROR_SAMPLES;
+
+    for(size_t mode = 0u; mode < (sizeof(mode_names) / sizeof(mode_names[0])); mode++)
+    {
+        int32_t q14_state[BIQUAD_STATE_WORDS] = { 0 };
+        biquad_q31_section q31_section;
+        biquad_f32_section f32_section;
+        biquad_f64_section f64_section;
+        absolute_time_t start_time = 0u;
+        filter_error error;
+
+        /* The first pass from zero state is checked against the reference, the rest are timed. */
+        for(size_t loop_var = 0u; loop_var <= iteration_count; loop_var++)
+        {
+            size_t length = (loop_var == 0u) ? error_length : buffer_length;
+
+            if(loop_var == 1u)
+            {
+                error = reference_error(&highpass_coeffs, in, out, error_length);
+                start_time = get_absolute_time();
+            }
+            switch(mode)
+            {
+                case 0u:
+                    biquad_df1_process(&highpass_coeffs, q14_state, in, out, length);
+                    break;
+                case 1u:
+                    if(loop_var == 0u)
+                    {
+                        biquad_q31_init(&q31_section, &highpass_coeffs);
+                    }
+                    biquad_q31_process(&q31_section, in, out, length);
+                    break;
+                case 2u:
+                    if(loop_var == 0u)
+                    {
+                        biquad_f32_init(&f32_section, &highpass_coeffs);
+                    }
+                    biquad_f32_process(&f32_section, in, out, length);
+                    break;
+                default:
+                    if(loop_var == 0u)
+                    {
+                        biquad_f64_init(&f64_section, &highpass_coeffs);
+                    }
+                    biquad_f64_process(&f64_section, in, out, length);
+                    break;
+            }
+        }
+
+        printf("[Core #%d] %s: %llu kiloSamples per second, SNR %.1f dB.\n", core_number, mode_names[mode],
+               bench_kilo_per_second(samples, bench_elapsed_us(start_time)), error.snr_db);
+    }
+}
+
+/* One section per compile-time designed preset, plus the cost of designing a section at runtime. */
+void biquad_design_benchmark(int16_t* in, int16_t* out, size_t buffer_length, size_t iteration_count, int core_number)
+{
+    uint64_t samples = (uint64_t)buffer_length * iteration_count;
+    size_t error_length = (buffer_length < ERROR_SAMPLES) ? buffer_length : ERROR_SAMPLES;
+    absolute_time_t start_time;
+    biquad_state state;
+    volatile biquad_coeffs retuned;
+
+    for(size_t preset = 0u; preset < biquad_design_preset_count; preset++)
+    {
+        filter_error error;
+
+        biquad_state_init(&state, &biquad_design_presets[preset].coeffs, 1u);
+        biquad_process_block(&state, in, out, error_length);
+        error = reference_error(&biquad_design_presets[preset].coeffs, in, out, error_length);
+
+        start_time = get_absolute_time();
+        for(size_t loop_var = 0u; loop_var < iteration_count; loop_var++)
+        {
+            biquad_process_block(&state, in, out, buffer_length);
+        }
+        printf("[Core #%d] %s: %llu kiloSamples per second, SNR %.1f dB.\n", core_number, biquad_design_presets[preset].name,
+               bench_kilo_per_second(samples, bench_elapsed_us(start_time)), error.snr_db);
+    }
+
+    start_time = get_absolute_time();
+    for(size_t i = 0u; i < RETUNE_COUNT; i++)
+    {
+        retuned = biquad_design(BIQUAD_PEAKING, BIQUAD_DESIGN_SAMPLE_RATE, 500.0 + (250.0 * i), 1.0, 3.0);
+    }
+    (void)retuned;
+    printf("[Core #%d] Runtime peaking design: %u sections in %llu microseconds.\n", core_number, RETUNE_COUNT, bench_elapsed_us(start_time));
+}
+
+typedef struct realtime_context_s
+{
+    biquad_state state;
+    const int16_t* in;
+    int16_t* out;
+    size_t blocks_per_buffer;
+} realtime_context;
+
+static void realtime_block(void* context, size_t block_index)
+{
+    realtime_context* realtime = context;
+    size_t offset = (block_index % realtime->blocks_per_buffer) * REALTIME_BLOCK;
+
+    biquad_process_block(&realtime->state, realtime->in + offset, realtime->out + offset, REALTIME_BLOCK);
+}
+
+/* Samples arrive a block at a time on a repeating alarm and the cascade runs in the alarm handler. */
+void biquad_realtime_benchmark(int16_t* in, int16_t* out, size_t buffer_length, int core_number)
+{
+    realtime_context context = { .in = in, .out = out, .blocks_per_buffer = buffer_length / REALTIME_BLOCK };
+    realtime_report report;
+    uint32_t max_rate;
+
+    biquad_state_init(&context.state, cascade_coeffs, SWEEP_SECTIONS);
+    if(!realtime_run(REALTIME_RATE, REALTIME_BLOCK, REALTIME_BLOCKS, realtime_block, &context, &report))
+    {
+        printf("[Core #%d] Could not start the sample clock.\n", core_number);
+        return;
+    }
+    printf("[Core #%d] Real time at %lu samples per second, %u-sample blocks: headroom %ld%%, worst handler %llu microseconds, %llu of %llu deadlines missed.\n",
+           core_number, (unsigned long)report.sample_rate, REALTIME_BLOCK, (long)report.headroom_percent, report.worst_handler_us,
+           report.missed_deadlines, report.blocks);
+
+    max_rate = realtime_search_max_rate(REALTIME_MIN_RATE, REALTIME_MAX_RATE, REALTIME_BLOCK, realtime_block, &context);
+    printf("[Core #%d] Highest sustainable rate with %u sections: %lu samples per second.\n", core_number, SWEEP_SECTIONS, (unsigned long)max_rate);
+}
+
+static void live_block(void* context, int16_t* block, size_t length)
+{
+    biquad_process_block(context, block, block, length);
+}
+
+/* Filters the live source in place in its DMA buffers, doubling the cascade until the filter can't keep up. */
+void biquad_live_benchmark(void)
+{
+    sample_source_config config = { .sample_rate = LIVE_RATE, .input_mask = LIVE_INPUTS, .block_length = LIVE_BLOCK,
+                                    .path = getenv(LIVE_PATH_ENV) };
+    biquad_state state;
+
+    for(size_t sections = 1u; sections <= BIQUAD_MAX_SECTIONS; sections = sections * 2u)
+    {
+        sample_source_report report;
+
+        biquad_state_init(&state, cascade_coeffs, sections);
+        if(!sample_source_run(&config, LIVE_BLOCKS, live_block, &state, &report))
+        {
+            printf("[Live] Could not start the sample source.\n");
+            return;
+        }
+        printf("[Live] %u sections at %lu samples per second: %llu blocks filtered, %llu overruns, filter busy %ld%% of the time.\n",
+               (unsigned)sections, (unsigned long)report.sample_rate, report.blocks, report.overruns, (long)report.utilisation_percent);
+        if(report.overruns != 0u)
+        {
+            break;
+        }
+    }
+}
+
+/* Each core filters its own small block from the bank core_placement picks, while the other core does the same. */
+static void placement_job(int core_number)
+{
+    int16_t (*block)[PLACEMENT_BLOCK];
+    biquad_state state;
+    absolute_time_t start_time;
+
+    if(core_number == 0)
+    {
+        block = (core_placement[0] == PLACEMENT_SCRATCH) ? core0_scratch_block : core0_striped_block;
+    }
+    else
+    {
+        block = (core_placement[1] == PLACEMENT_SCRATCH) ? core1_scratch_block : core1_striped_block;
+    }
+    memcpy(block[0], core_buffers[core_number].in, sizeof(block[0]));
+    biquad_state_init(&state, cascade_coeffs, SWEEP_SECTIONS);
+
+    start_time = get_absolute_time();
+    for(size_t loop_var = 0u; loop_var < PLACEMENT_ITERATIONS; loop_var++)
+    {
+        biquad_process_block(&state, block[0], block[1], PLACEMENT_BLOCK);
+    }
+    placement_rates[core_number] = bench_kilo_per_second((uint64_t)PLACEMENT_BLOCK * PLACEMENT_ITERATIONS, bench_elapsed_us(start_time));
+}
+
+void biquad_placement_benchmark(void)
+{
+    static const char* const bank_names[] = { "striped SRAM0-3", "scratch bank" };
+    static const placement layouts[][2u] =
+    {
+        { PLACEMENT_STRIPED, PLACEMENT_STRIPED },
+        { PLACEMENT_SCRATCH, PLACEMENT_SCRATCH },
+        { PLACEMENT_SCRATCH, PLACEMENT_STRIPED },
+        { PLACEMENT_STRIPED, PLACEMENT_SCRATCH },
+    };
+    uint64_t single_rate;
+
+    core_placement[0] = PLACEMENT_STRIPED;
+    placement_job(0);
+    single_rate = placement_rates[0];
+    printf("[Placement] Core 0 alone, %s: %llu kiloSamples per second.\n", bank_names[PLACEMENT_STRIPED], single_rate);
+
+    for(size_t layout = 0u; layout < (sizeof(layouts) / sizeof(layouts[0])); layout++)
+    {
+        uint64_t combined_rate;
+
+        core_placement[0] = layouts[layout][0];
+        core_placement[1] = layouts[layout][1];
+        bench_run_on_both_cores(placement_job);
+        combined_rate = placement_rates[0] + placement_rates[1];
+        printf("[Placement] Core 0 %s, core 1 %s: %llu + %llu = %llu kiloSamples per second, %llu.%02llux core 0 alone.\n",
+               bank_names[layouts[layout][0]], bank_names[layouts[layout][1]], placement_rates[0], placement_rates[1], combined_rate,
+               combined_rate / single_rate, (combined_rate * 100u / single_rate) % 100u);
+    }
+}
+
+static void cascade_job(int core_number)
+{
+    bench_buffers* buffers = &core_buffers[core_number];
+    biquad_benchmark(buffers->in, buffers->out, buffers->length, ITERATIONS, core_number);
+}
+
+static void block_size_job(int core_number)
+{
+    bench_buffers* buffers = &core_buffers[core_number];
+    biquad_block_size_benchmark(buffers->in, buffers->out, buffers->length, ITERATIONS, core_number);
+}
+
+static void layout_job(int core_number)
+{
+    bench_buffers* buffers = &core_buffers[core_number];
+    biquad_layout_benchmark(buffers->in, buffers->out, buffers->length, ITERATIONS, core_number);
+}
+
+static void swar_job(int core_number)
+{
+    bench_buffers* buffers = &core_buffers[core_number];
+    biquad_swar_benchmark(buffers->in, buffers->out, buffers->length, ITERATIONS, core_number);
+}
+
+static void fir_job(int core_number)
+{
+    bench_buffers* buffers = &core_buffers[core_number];
+    fir_benchmark(buffers->in, buffers->out, buffers->length, core_number);
+}
+
+static void topology_job(int core_number)
+{
+    bench_buffers* buffers = &core_buffers[core_number];
+    biquad_topology_benchmark(buffers->in, buffers->out, buffers->length, ITERATIONS, core_number);
+}
+
+static void asm_job(int core_number)
+{
+    biquad_asm_benchmark(core_buffers[core_number].in, core_buffers[core_number].out, core_buffers[core_number].length, ITERATIONS,
+                         core_number);
+}
+
+static void precision_job(int core_number)
+{
+    bench_buffers* buffers = &core_buffers[core_number];
+    biquad_precision_benchmark(buffers->in, buffers->out, buffers->length, PRECISION_ITERATIONS, core_number);
+}
+
+static void lookahead_worker_job(int core_number)
+{
+    (void)core_number;
+    biquad_lookahead_worker();
+}
+
+/* One channel through the same cascade serially on core 0 and block-parallel on both cores, signed with a CRC. */
+void biquad_lookahead_benchmark(size_t iteration_count)
 {
+    bench_buffers* buffers = &core_buffers[0];
+    size_t blocks_per_buffer = buffers->length / LOOKAHEAD_BLOCK;
+    size_t block_count = blocks_per_buffer * iteration_count;
+    uint64_t samples = (uint64_t)block_count * LOOKAHEAD_BLOCK;
+    uint64_t serial_us, parallel_us;
+    uint32_t serial_crc = 0u, parallel_crc = 0u;
     absolute_time_t start_time;
-    size_t duration_ms;
-    volatile int16_t in[ARRAY_SIZE];
-    volatile int16_t out[ARRAY_SIZE];
-    int16_t z1, z2;
-    int16_t outTemp;
-    int16_t inTemp;
-    uint64_t counter = 1;
+    biquad_state serial_state;
 
-    while(1) 
+    biquad_state_init(&serial_state, cascade_coeffs, LOOKAHEAD_SECTIONS);
+    start_time = get_absolute_time();
+    for(size_t block = 0u; block < block_count; block++)
     {
-        start_time = get_absolute_time();
-        for(size_t loop_var = 0u; loop_var < ITERATIONS; loop_var++)
+        int16_t* out = buffers->out + ((block % blocks_per_buffer) * LOOKAHEAD_BLOCK);
+
+        biquad_process_block(&serial_state, buffers->in + ((block % blocks_per_buffer) * LOOKAHEAD_BLOCK), out, LOOKAHEAD_BLOCK);
+        serial_crc = verify_crc32(out, LOOKAHEAD_BLOCK, serial_crc);
+    }
+    serial_us = bench_elapsed_us(start_time);
+
+    biquad_lookahead_init(&lookahead_state, cascade_coeffs, LOOKAHEAD_SECTIONS);
+    bench_launch_on_core1(lookahead_worker_job);
+    start_time = get_absolute_time();
+    for(size_t block = 0u; block < block_count; block++)
+    {
+        int16_t* out = buffers->out + ((block % blocks_per_buffer) * LOOKAHEAD_BLOCK);
+
+        biquad_lookahead_process(&lookahead_state, buffers->in + ((block % blocks_per_buffer) * LOOKAHEAD_BLOCK), out, bench_scratch.lookahead,
+                                 LOOKAHEAD_BLOCK);
+        parallel_crc = verify_crc32(out, LOOKAHEAD_BLOCK, parallel_crc);
+    }
+    parallel_us = bench_elapsed_us(start_time);
+    biquad_lookahead_stop();
+    bench_wait_core1();
+
+    if(parallel_crc != serial_crc)
+    {
+        printf("[Lookahead] ERROR! crc32 0x%08lx - should be 0x%08lx.\n", (unsigned long)parallel_crc, (unsigned long)serial_crc);
+    }
+    printf("[Lookahead] %u sections, %u-sample blocks: serial %llu kiloSamples per second on core 0.\n", LOOKAHEAD_SECTIONS, LOOKAHEAD_BLOCK,
+           bench_kilo_per_second(samples, serial_us));
+#if BIQUAD_LOOKAHEAD_PARALLEL
+    printf("[Lookahead] Two-core block-parallel: %llu kiloSamples per second, %llu.%02llux speedup on one channel.\n",
+           bench_kilo_per_second(samples, parallel_us), serial_us / parallel_us, (serial_us * 100u / parallel_us) % 100u);
+    printf("[Lookahead] Impulse tail %zu samples, fix-up averaged %llu samples per section, %llu of %llu ran to the end of the block.\n",
+           lookahead_state.tail_length[0], lookahead_state.fixup_samples / ((uint64_t)block_count * LOOKAHEAD_SECTIONS),
+           lookahead_state.unmerged_sections, (uint64_t)block_count * LOOKAHEAD_SECTIONS);
+#else
+    printf("[Lookahead] DF2 sections have no DF1 twin, fell back to serial on core 0: %llu kiloSamples per second.\n",
+           bench_kilo_per_second(samples, parallel_us));
+#endif
+}
+
+static void fft_worker_job(int core_number)
+{
+    (void)core_number;
+    fft_worker();
+}
+
+/* Plain radix-2 in double precision, the yardstick for the Q15 transforms. */
+static void reference_fft(double* data, size_t points)
+{
+    const double pi = 3.14159265358979323846;
+
+    for(size_t i = 0u, j = 0u; i < points; i++)
+    {
+        if(i < j)
+        {
+            double re = data[2u * i], im = data[(2u * i) + 1u];
+
+            data[2u * i] = data[2u * j];
+            data[(2u * i) + 1u] = data[(2u * j) + 1u];
+            data[2u * j] = re;
+            data[(2u * j) + 1u] = im;
+        }
+        for(size_t bit = points >> 1u; bit != 0u; bit = bit >> 1u)
         {
-            for(size_t i = 0; i < ARRAY_SIZE; i++)
+            j = j ^ bit;
+            if((j & bit) != 0u)
             {
-                inTemp = in[i];
-                outTemp = inTemp * a0 + z1;
-                z1 = inTemp * a1 + z2 - b1 * outTemp;
-                z2 = inTemp * a2 - b2 * outTemp;
-                out[i] = outTemp;
+                break;
             }
         }
-        duration_ms = absolute_time_diff_us(start_time, get_absolute_time()) / 1000;
-        printf("[Core #1] Finished iteration #%llu.\n", counter);
-        printf("[Core #1] Finished %u samples in %zu milliseconds.\n", ARRAY_SIZE * ITERATIONS, duration_ms);
-        printf("[Core #1] %zu kiloSamples per second.\n", ARRAY_SIZE * ITERATIONS / duration_ms);
-        counter = counter + 1;
     }
+    for(size_t length = 2u; length <= points; length = length * 2u)
+    {
+        for(size_t k = 0u; k < length / 2u; k++)
+        {
+            double wr = cos((2.0 * pi * k) / length), wi = -sin((2.0 * pi * k) / length);
+
+            for(size_t group = 0u; group < points; group = group + length)
+            {
+                double* a = &data[2u * (group + k)];
+                double* b = &data[2u * (group + k + (length / 2u))];
+                double br = b[0] * wr - b[1] * wi, bi = b[0] * wi + b[1] * wr;
+
+                b[0] = a[0] - br;
+                b[1] = a[1] - bi;
+                a[0] = a[0] + br;
+                a[1] = a[1] + bi;
+            }
+        }
+    }
+}
+
+/* SNR of out * 2^exponent against the double transform of in. Real transforms compare their packed bins. */
+static double fft_snr_db(const int16_t* in, const int16_t* out, int exponent, size_t points, bool real)
+{
+    double scale = ldexp(1.0, exponent);
+    double signal_power = 0.0, noise_power = 0.0;
+    size_t bins = real ? (points / 2u) : points;
+
+    for(size_t i = 0u; i < points; i++)
+    {
+        bench_scratch.fft_reference[2u * i] = real ? in[i] : in[2u * i];
+        bench_scratch.fft_reference[(2u * i) + 1u] = real ? 0.0 : in[(2u * i) + 1u];
+    }
+    reference_fft(bench_scratch.fft_reference, points);
+    if(real)
+    {
+        /* Bin points / 2 is real and packed where bin 0's imaginary part would be. */
+        bench_scratch.fft_reference[1] = bench_scratch.fft_reference[points];
+    }
+    for(size_t i = 0u; i < 2u * bins; i++)
+    {
+        double error = bench_scratch.fft_reference[i] - (out[i] * scale);
+
+        signal_power = signal_power + (bench_scratch.fft_reference[i] * bench_scratch.fft_reference[i]);
+        noise_power = noise_power + (error * error);
+    }
+    return (noise_power > 0.0) ? 10.0 * log10(signal_power / noise_power) : INFINITY;
+}
+
+/* Complex transforms on one core and split across both, then the real-input variant, 64 to FFT_MAX_POINTS points. */
+void fft_benchmark(void)
+{
+    bench_buffers* buffers = &core_buffers[0];
+    absolute_time_t start_time;
+
+    for(size_t points = FFT_MIN_POINTS; points <= FFT_MAX_POINTS; points = points * 2u)
+    {
+        size_t butterflies = fft_butterflies(points);
+        size_t iteration_count = (FFT_BUTTERFLY_BUDGET / butterflies) + 1u;
+        uint64_t single_us, dual_us, real_us;
+        uint32_t single_crc;
+        int single_exponent, dual_exponent;
+        bool checked = points <= FFT_CHECK_POINTS;
+        double complex_snr = 0.0, real_snr = 0.0;
+
+        memcpy(buffers->out, buffers->in, 2u * points * sizeof(int16_t));
+        single_exponent = fft_complex(buffers->out, points);
+        single_crc = verify_crc32(buffers->out, 2u * points, 0u);
+        complex_snr = checked ? fft_snr_db(buffers->in, buffers->out, single_exponent, points, false) : 0.0;
+        start_time = get_absolute_time();
+        for(size_t loop_var = 0u; loop_var < iteration_count; loop_var++)
+        {
+            fft_complex(buffers->out, points);
+        }
+        single_us = bench_elapsed_us(start_time);
+
+        bench_launch_on_core1(fft_worker_job);
+        memcpy(buffers->out, buffers->in, 2u * points * sizeof(int16_t));
+        dual_exponent = fft_complex_dual(buffers->out, points);
+        if((dual_exponent != single_exponent) || (verify_crc32(buffers->out, 2u * points, 0u) != single_crc))
+        {
+            printf("[FFT] ERROR! %zu points: the two-core transform differs from the single-core one.\n", points);
+        }
+        start_time = get_absolute_time();
+        for(size_t loop_var = 0u; loop_var < iteration_count; loop_var++)
+        {
+            fft_complex_dual(buffers->out, points);
+        }
+        dual_us = bench_elapsed_us(start_time);
+        fft_stop();
+        bench_wait_core1();
+
+        memcpy(buffers->out, buffers->in, points * sizeof(int16_t));
+        real_snr = checked ? fft_snr_db(buffers->in, buffers->out, fft_real(buffers->out, points), points, true) : 0.0;
+        start_time = get_absolute_time();
+        for(size_t loop_var = 0u; loop_var < iteration_count; loop_var++)
+        {
+            fft_real(buffers->out, points);
+        }
+        real_us = bench_elapsed_us(start_time);
+
+        printf("[FFT] %zu points: %llu transforms per second on one core, %llu.%llu cycles per butterfly", points,
+               ((uint64_t)iteration_count * 1000000u) / single_us,
+               tenths_of_cycles_per_sample((uint64_t)iteration_count * butterflies, single_us) / 10u,
+               tenths_of_cycles_per_sample((uint64_t)iteration_count * butterflies, single_us) % 10u);
+        printf(checked ? ", SNR %.1f dB.\n" : ".\n", complex_snr);
+        printf("[FFT] %zu points: %llu transforms per second on two cores, %llu.%02llux.\n", points,
+               ((uint64_t)iteration_count * 1000000u) / dual_us, single_us / dual_us, (single_us * 100u / dual_us) % 100u);
+        printf("[FFT] %zu real points: %llu transforms per second", points, ((uint64_t)iteration_count * 1000000u) / real_us);
+        printf(checked ? ", SNR %.1f dB.\n" : ".\n", real_snr);
+    }
+}
+
+static void goertzel_worker_job(int core_number)
+{
+    (void)core_number;
+    goertzel_worker();
+}
+
+/* Largest gap in dB between the bank and the real FFT of the same block, over bins within GOERTZEL_RANGE_DB of the peak. */
+static double goertzel_fft_difference_db(const goertzel_bank* bank, const uint64_t* power, const int16_t* spectrum, int exponent)
+{
+    double fft_power[GOERTZEL_MAX_BINS];
+    double strongest = 0.0, difference = 0.0;
+
+    for(size_t bin = 0u; bin < bank->bin_count; bin++)
+    {
+        size_t k = (size_t)floor(goertzel_frequencies[bin] * GOERTZEL_BLOCK + 0.5);
+        double re = spectrum[2u * k], im = spectrum[(2u * k) + 1u];
+
+        fft_power[bin] = ldexp(re * re + im * im, 2 * exponent);
+        strongest = (fft_power[bin] > strongest) ? fft_power[bin] : strongest;
+    }
+    for(size_t bin = 0u; bin < bank->bin_count; bin++)
+    {
+        double goertzel = ldexp((double)power[bin], 2 * (int)bank->input_shift);
+
+        if((fft_power[bin] > 0.0) && (goertzel > 0.0) && (10.0 * log10(strongest / fft_power[bin]) < GOERTZEL_RANGE_DB))
+        {
+            double gap = fabs(10.0 * log10(goertzel / fft_power[bin]));
+
+            difference = (gap > difference) ? gap : difference;
+        }
+    }
+    return difference;
+}
+
+/* Banks of 1 to GOERTZEL_MAX_BINS bins on one core and split across two, against a real FFT of the whole block
+ * plus the power of every bin. The crossover is the smallest bank that takes longer than the FFT. */
+void goertzel_benchmark(void)
+{
+    bench_buffers* buffers = &core_buffers[0];
+    absolute_time_t start_time;
+    uint64_t fft_us;
+    size_t single_crossover = 0u, dual_crossover = 0u;
+    int exponent;
+
+    signal_generate(SIGNAL_NOISE, goertzel_input, GOERTZEL_BLOCK);
+    start_time = get_absolute_time();
+    for(size_t block = 0u; block < GOERTZEL_BLOCKS; block++)
+    {
+        uint64_t total = 0u;
+
+        memcpy(buffers->out, goertzel_input, sizeof(goertzel_input));
+        fft_real(buffers->out, GOERTZEL_BLOCK);
+        for(size_t i = 2u; i < GOERTZEL_BLOCK; i = i + 2u)
+        {
+            total = total + (uint32_t)((buffers->out[i] * buffers->out[i]) + (buffers->out[i + 1u] * buffers->out[i + 1u]));
+        }
+        goertzel_sink = total;
+    }
+    fft_us = bench_elapsed_us(start_time);
+    memcpy(buffers->out, goertzel_input, sizeof(goertzel_input));
+    exponent = fft_real(buffers->out, GOERTZEL_BLOCK);
+    printf("[Goertzel] %u-point real FFT and power: %llu blocks per second.\n", GOERTZEL_BLOCK,
+           ((uint64_t)GOERTZEL_BLOCKS * 1000000u) / fft_us);
+
+    for(size_t bin_count = 1u; bin_count <= GOERTZEL_MAX_BINS; bin_count = bin_count * 2u)
+    {
+        size_t split = bin_count / 2u;
+        uint64_t single_us, dual_us;
+
+        /* Whole FFT bins spread over the band, so the FFT can vouch for them. */
+        for(size_t bin = 0u; bin < bin_count; bin++)
+        {
+            goertzel_frequencies[bin] = (double)(((bin + 1u) * (GOERTZEL_BLOCK / 2u)) / (bin_count + 1u)) / GOERTZEL_BLOCK;
+        }
+
+        goertzel_init(&goertzel_banks[0], goertzel_frequencies, bin_count, GOERTZEL_BLOCK);
+        start_time = get_absolute_time();
+        for(size_t block = 0u; block < GOERTZEL_BLOCKS; block++)
+        {
+            goertzel_process(&goertzel_banks[0], goertzel_input, GOERTZEL_BLOCK);
+            goertzel_finish(&goertzel_banks[0], goertzel_power);
+        }
+        single_us = bench_elapsed_us(start_time);
+
+        /* Core 0 keeps the first half of the bins, which is all of them for a single bin. */
+        goertzel_init(&goertzel_banks[0], goertzel_frequencies, bin_count - split, GOERTZEL_BLOCK);
+        goertzel_init(&goertzel_banks[1], goertzel_frequencies + (bin_count - split), split, GOERTZEL_BLOCK);
+        bench_launch_on_core1(goertzel_worker_job);
+        start_time = get_absolute_time();
+        for(size_t block = 0u; block < GOERTZEL_BLOCKS; block++)
+        {
+            goertzel_process_dual(&goertzel_banks[0], &goertzel_banks[1], goertzel_input, GOERTZEL_BLOCK);
+            goertzel_finish(&goertzel_banks[0], goertzel_power);
+            goertzel_finish(&goertzel_banks[1], goertzel_power + (bin_count - split));
+        }
+        dual_us = bench_elapsed_us(start_time);
+        goertzel_stop();
+        bench_wait_core1();
+
+        single_crossover = ((single_crossover == 0u) && (single_us > fft_us)) ? bin_count : single_crossover;
+        dual_crossover = ((dual_crossover == 0u) && (dual_us > fft_us)) ? bin_count : dual_crossover;
+        printf("[Goertzel] %zu bins: %llu blocks per second on one core, %llu on two.\n", bin_count,
+               ((uint64_t)GOERTZEL_BLOCKS * 1000000u) / single_us, ((uint64_t)GOERTZEL_BLOCKS * 1000000u) / dual_us);
+    }
+
+    /* One full bank for the accuracy check, so every bin shares one input shift. The frequencies are the last set. */
+    goertzel_init(&goertzel_banks[0], goertzel_frequencies, GOERTZEL_MAX_BINS, GOERTZEL_BLOCK);
+    goertzel_process(&goertzel_banks[0], goertzel_input, GOERTZEL_BLOCK);
+    goertzel_finish(&goertzel_banks[0], goertzel_power);
+    printf("[Goertzel] %u bins agree with the FFT bins within %.2f dB.\n", GOERTZEL_MAX_BINS,
+           goertzel_fft_difference_db(&goertzel_banks[0], goertzel_power, buffers->out, exponent));
+    if(single_crossover != 0u)
+    {
+        printf("[Goertzel] The FFT wins from %zu bins on one core", single_crossover);
+    }
+    else
+    {
+        printf("[Goertzel] The bank beats the FFT up to %u bins on one core", GOERTZEL_MAX_BINS);
+    }
+    if(dual_crossover != 0u)
+    {
+        printf(", from %zu bins on two.\n", dual_crossover);
+    }
+    else
+    {
+        printf(", and up to %u bins on two.\n", GOERTZEL_MAX_BINS);
+    }
+}
+
+static void design_job(int core_number)
+{
+    bench_buffers* buffers = &core_buffers[core_number];
+    biquad_design_benchmark(buffers->in, buffers->out, buffers->length, ITERATIONS, core_number);
+}
+
+static void realtime_job(int core_number)
+{
+    bench_buffers* buffers = &core_buffers[core_number];
+    biquad_realtime_benchmark(buffers->in, buffers->out, buffers->length, core_number);
+}
+
+/* Second pipeline stage on core 1: takes filled slots in order, writes the final output, hands the slot back. */
+static void pipeline_stage2_job(int core_number)
+{
+    bench_buffers* buffers = &core_buffers[0];
+    size_t blocks_per_buffer = buffers->length / PIPELINE_BLOCK;
+    size_t block = 0u;
+    uint64_t busy_us = 0u;
+    uint32_t slot;
+
+    (void)core_number;
+    while((slot = multicore_fifo_pop_blocking()) != PIPELINE_END)
+    {
+        absolute_time_t start_time = get_absolute_time();
+        biquad_process_block(&pipeline_stages[1], pipeline_slots[slot], buffers->out + ((block % blocks_per_buffer) * PIPELINE_BLOCK), PIPELINE_BLOCK);
+        busy_us = busy_us + absolute_time_diff_us(start_time, get_absolute_time());
+        block = block + 1u;
+        multicore_fifo_push_blocking(slot);
+    }
+    pipeline_stage2_busy_us = busy_us;
+}
+
+/* Core 0 runs the first half of the cascade on block N while core 1 runs the second half on block N-1. */
+void biquad_pipeline_benchmark(size_t iteration_count)
+{
+    bench_buffers* buffers = &core_buffers[0];
+    size_t blocks_per_buffer = buffers->length / PIPELINE_BLOCK;
+    size_t block_count = blocks_per_buffer * iteration_count;
+    uint64_t samples = (uint64_t)block_count * PIPELINE_BLOCK;
+    uint64_t stage1_busy_us = 0u;
+    uint64_t serial_us, pipeline_us;
+    size_t free_slots = PIPELINE_SLOTS;
+    absolute_time_t start_time;
+    biquad_state serial_state;
+
+    biquad_state_init(&serial_state, cascade_coeffs, PIPELINE_SECTIONS);
+    start_time = get_absolute_time();
+    for(size_t block = 0u; block < block_count; block++)
+    {
+        biquad_process_block(&serial_state, buffers->in + ((block % blocks_per_buffer) * PIPELINE_BLOCK),
+                             buffers->out + ((block % blocks_per_buffer) * PIPELINE_BLOCK), PIPELINE_BLOCK);
+    }
+    serial_us = bench_elapsed_us(start_time);
+
+    biquad_state_init(&pipeline_stages[0], cascade_coeffs, PIPELINE_SPLIT);
+    biquad_state_init(&pipeline_stages[1], cascade_coeffs + PIPELINE_SPLIT, PIPELINE_SECTIONS - PIPELINE_SPLIT);
+    bench_launch_on_core1(pipeline_stage2_job);
+    start_time = get_absolute_time();
+    for(size_t block = 0u; block < block_count; block++)
+    {
+        uint32_t slot = block % PIPELINE_SLOTS;
+        absolute_time_t stage_start_time;
+
+        /* Slots come back in the order they were sent, so the oldest one is the next one we need. */
+        if(free_slots == 0u)
+        {
+            multicore_fifo_pop_blocking();
+            free_slots = free_slots + 1u;
+        }
+        stage_start_time = get_absolute_time();
+        biquad_process_block(&pipeline_stages[0], buffers->in + ((block % blocks_per_buffer) * PIPELINE_BLOCK),
+                             pipeline_slots[slot], PIPELINE_BLOCK);
+        stage1_busy_us = stage1_busy_us + absolute_time_diff_us(stage_start_time, get_absolute_time());
+        multicore_fifo_push_blocking(slot);
+        free_slots = free_slots - 1u;
+    }
+    multicore_fifo_push_blocking(PIPELINE_END);
+    for(; free_slots < PIPELINE_SLOTS; free_slots++)
+    {
+        multicore_fifo_pop_blocking();
+    }
+    pipeline_us = bench_elapsed_us(start_time);
+    bench_wait_core1();
+
+    printf("[Pipeline] %u sections, %u-sample blocks: serial %llu kiloSamples per second on core 0.\n", PIPELINE_SECTIONS, PIPELINE_BLOCK,
+           bench_kilo_per_second(samples, serial_us));
+    printf("[Pipeline] Two-core pipeline: %llu kiloSamples per second end to end, %llu.%02llux speedup.\n", bench_kilo_per_second(samples, pipeline_us),
+           serial_us / pipeline_us, (serial_us * 100u / pipeline_us) % 100u);
+    printf("[Pipeline] Stage utilisation: core 0 %llu%%, core 1 %llu%%.\n", stage1_busy_us * 100u / pipeline_us,
+           pipeline_stage2_busy_us * 100u / pipeline_us);
+}
+
+/* Block N's last sample arrives N + 1 block periods after the start, which is when the block can enter the filter. */
+static absolute_time_t latency_ingress_time(absolute_time_t start_time, size_t block, size_t block_length)
+{
+    return delayed_by_us(start_time, ((uint64_t)(block + 1u) * block_length * 1000000u) / LATENCY_RATE);
+}
+
+static void latency_wait_until(absolute_time_t target)
+{
+    while(absolute_time_diff_us(get_absolute_time(), target) > 0)
+    {
+        tight_loop_contents();
+    }
+}
+
+static uint32_t latency_since(absolute_time_t ingress)
+{
+    int64_t latency_us = absolute_time_diff_us(ingress, get_absolute_time());
+    return (latency_us > 0) ? (uint32_t)latency_us : 0u;
+}
+
+/* Core 0 filters each block with the whole cascade as soon as it is complete. */
+static void latency_single_core_run(size_t block_length, size_t block_count)
+{
+    bench_buffers* buffers = &core_buffers[0];
+    size_t blocks_per_buffer = buffers->length / block_length;
+    absolute_time_t start_time;
+    biquad_state state;
+
+    biquad_state_init(&state, cascade_coeffs, PIPELINE_SECTIONS);
+    latency_reset(&latency_histograms[0]);
+    start_time = get_absolute_time();
+    for(size_t block = 0u; block < block_count; block++)
+    {
+        absolute_time_t ingress = latency_ingress_time(start_time, block, block_length);
+        size_t offset = (block % blocks_per_buffer) * block_length;
+
+        latency_wait_until(ingress);
+        biquad_process_block(&state, buffers->in + offset, buffers->out + offset, block_length);
+        latency_record(&latency_histograms[0], latency_since(ingress));
+    }
+}
+
+/* Second stage on core 1: records the end-to-end latency of every block into its own histogram. */
+static void latency_stage2_job(int core_number)
+{
+    bench_buffers* buffers = &core_buffers[0];
+    size_t block_length = latency_block_length;
+    size_t blocks_per_buffer = buffers->length / block_length;
+    size_t block = 0u;
+    uint32_t slot;
+
+    (void)core_number;
+    latency_reset(&latency_histograms[1]);
+    while((slot = multicore_fifo_pop_blocking()) != PIPELINE_END)
+    {
+        biquad_process_block(&pipeline_stages[1], pipeline_slots[slot], buffers->out + ((block % blocks_per_buffer) * block_length), block_length);
+        latency_record(&latency_histograms[1], latency_since(latency_ingress[slot]));
+        block = block + 1u;
+        multicore_fifo_push_blocking(slot);
+    }
+}
+
+/* Core 0 runs the first half of the cascade and hands the block over; core 0 records the latency to the handoff. */
+static void latency_pipeline_run(size_t block_length, size_t block_count)
+{
+    bench_buffers* buffers = &core_buffers[0];
+    size_t blocks_per_buffer = buffers->length / block_length;
+    size_t free_slots = PIPELINE_SLOTS;
+    absolute_time_t start_time;
+
+    biquad_state_init(&pipeline_stages[0], cascade_coeffs, PIPELINE_SPLIT);
+    biquad_state_init(&pipeline_stages[1], cascade_coeffs + PIPELINE_SPLIT, PIPELINE_SECTIONS - PIPELINE_SPLIT);
+    latency_reset(&latency_histograms[0]);
+    latency_block_length = block_length;
+    bench_launch_on_core1(latency_stage2_job);
+    start_time = get_absolute_time();
+    for(size_t block = 0u; block < block_count; block++)
+    {
+        absolute_time_t ingress = latency_ingress_time(start_time, block, block_length);
+        uint32_t slot = block % PIPELINE_SLOTS;
+
+        latency_wait_until(ingress);
+        if(free_slots == 0u)
+        {
+            multicore_fifo_pop_blocking();
+            free_slots = free_slots + 1u;
+        }
+        biquad_process_block(&pipeline_stages[0], buffers->in + ((block % blocks_per_buffer) * block_length), pipeline_slots[slot], block_length);
+        latency_ingress[slot] = ingress;
+        latency_record(&latency_histograms[0], latency_since(ingress));
+        multicore_fifo_push_blocking(slot);
+        free_slots = free_slots - 1u;
+    }
+    while(free_slots < PIPELINE_SLOTS)
+    {
+        multicore_fifo_pop_blocking();
+        free_slots = free_slots + 1u;
+    }
+    multicore_fifo_push_blocking(PIPELINE_END);
+    bench_wait_core1();
+}
+
+/* Paced input at LATENCY_RATE, so the numbers include waiting behind earlier blocks and not just filtering time. */
+void biquad_latency_benchmark(void)
+{
+    printf("[Latency] %u sections at %u samples per second, from a block's last sample to its output; the first sample also waits the block's length.\n",
+           PIPELINE_SECTIONS, LATENCY_RATE);
+    for(size_t block_length = LATENCY_MIN_BLOCK; block_length <= PIPELINE_BLOCK; block_length = block_length * 2u)
+    {
+        size_t block_count = ((uint64_t)LATENCY_RATE * LATENCY_RUN_MS) / (1000u * block_length);
+        uint32_t single_p50, single_p99, single_max;
+
+        latency_single_core_run(block_length, block_count);
+        single_p50 = latency_percentile(&latency_histograms[0], 50u);
+        single_p99 = latency_percentile(&latency_histograms[0], 99u);
+        single_max = latency_histograms[0].max_us;
+        latency_pipeline_run(block_length, block_count);
+        printf("[Latency] %3u-sample blocks (%llu us to fill): one core p50 %lu us, p99 %lu us, max %lu us; pipelined p50 %lu us, p99 %lu us, max %lu us, stage 1 p99 %lu us.\n",
+               (unsigned)block_length, ((uint64_t)block_length * 1000000u) / LATENCY_RATE, (unsigned long)single_p50,
+               (unsigned long)single_p99, (unsigned long)single_max, (unsigned long)latency_percentile(&latency_histograms[1], 50u),
+               (unsigned long)latency_percentile(&latency_histograms[1], 99u), (unsigned long)latency_histograms[1].max_us,
+               (unsigned long)latency_percentile(&latency_histograms[0], 99u));
+    }
+}
+
+/* Set N is always eq_sets[N % EQ_SETS], so after a swap, ramped or not, the cascade must hold exactly that set. */
+static bool eq_holds_acquired_set(const biquad_eq* filter)
+{
+    const biquad_coeffs* expected = eq_sets[filter->acquired % EQ_SETS];
+
+    for(size_t band = 0u; band < filter->band_count; band++)
+    {
+        if(memcmp(&filter->state.sections[band].coeffs, &expected[band], sizeof(biquad_coeffs)) != 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Eight peaking bands an octave apart from 62.5 Hz, each set with a different mix of gains within +-6 dB. */
+static void eq_design_sets(void)
+{
+    for(size_t set = 0u; set < EQ_SETS; set++)
+    {
+        for(size_t band = 0u; band < EQ_BANDS; band++)
+        {
+            double gain_db = (double)(int)(((set * 5u) + (band * 3u)) % 13u) - 6.0;
+
+            eq_sets[set][band] = biquad_design(BIQUAD_PEAKING, BIQUAD_DESIGN_SAMPLE_RATE, 62.5 * (double)(1u << band), 1.0, gain_db);
+        }
+    }
+}
+
+/* The audio side on core 1: filters EQ_BLOCKS blocks, checking each swap it takes, then tells core 0 it is done. */
+static void eq_worker_job(int core_number)
+{
+    bench_buffers* buffers = &core_buffers[1];
+    size_t blocks_per_buffer = buffers->length / EQ_BLOCK;
+    uint32_t torn = 0u;
+    absolute_time_t start_time = get_absolute_time();
+
+    (void)core_number;
+    for(size_t block = 0u; block < EQ_BLOCKS; block++)
+    {
+        size_t offset = (block % blocks_per_buffer) * EQ_BLOCK;
+
+        biquad_eq_process(&eq, buffers->in + offset, buffers->out + offset, EQ_BLOCK);
+        torn = torn + (eq_holds_acquired_set(&eq) ? 0u : 1u);
+    }
+    eq_core1_us = bench_elapsed_us(start_time);
+    eq_torn_sets = torn;
+    eq_done = true;
+}
+
+/* Core 1 filters while core 0 publishes the next set as fast as core 1 takes them, or not at all. */
+static uint64_t eq_two_core_run(bool ramp, bool retune, uint32_t* torn)
+{
+    biquad_eq_init(&eq, eq_sets[0], EQ_BANDS, ramp);
+    eq_done = false;
+    bench_launch_on_core1(eq_worker_job);
+    while(!eq_done)
+    {
+        if(retune)
+        {
+            biquad_eq_publish(&eq, eq_sets[(eq.published + 1u) % EQ_SETS]);
+        }
+        tight_loop_contents();
+    }
+    bench_wait_core1();
+    *torn = *torn + eq_torn_sets;
+    return eq_core1_us;
+}
+
+/* One core alone, publishing before every block or never, so the difference is what a swap costs end to end. */
+static uint64_t eq_one_core_run(bool ramp, bool retune)
+{
+    bench_buffers* buffers = &core_buffers[0];
+    size_t blocks_per_buffer = buffers->length / EQ_BLOCK;
+    absolute_time_t start_time;
+
+    biquad_eq_init(&eq, eq_sets[0], EQ_BANDS, ramp);
+    start_time = get_absolute_time();
+    for(size_t block = 0u; block < EQ_BLOCKS; block++)
+    {
+        size_t offset = (block % blocks_per_buffer) * EQ_BLOCK;
+
+        if(retune)
+        {
+            biquad_eq_publish(&eq, eq_sets[(block + 1u) % EQ_SETS]);
+        }
+        biquad_eq_process(&eq, buffers->in + offset, buffers->out + offset, EQ_BLOCK);
+    }
+    return bench_elapsed_us(start_time);
+}
+
+static int64_t eq_nanoseconds_per_swap(uint64_t swapping_us, uint64_t static_us)
+{
+    return (((int64_t)swapping_us - (int64_t)static_us) * 1000) / (int64_t)EQ_BLOCKS;
+}
+
+void biquad_eq_benchmark(void)
+{
+    uint64_t samples = (uint64_t)EQ_BLOCKS * EQ_BLOCK;
+    uint64_t static_us, step_us, ramp_us;
+    uint32_t swaps;
+    uint32_t torn = 0u;
+
+    eq_design_sets();
+    static_us = eq_one_core_run(false, false);
+    step_us = eq_one_core_run(false, true);
+    ramp_us = eq_one_core_run(true, true);
+    printf("[EQ] %u bands, %u-sample blocks: a swap every block costs %lld ns stepped, %lld ns ramped over %u steps.\n", EQ_BANDS,
+           EQ_BLOCK, (long long)eq_nanoseconds_per_swap(step_us, static_us), (long long)eq_nanoseconds_per_swap(ramp_us, static_us),
+           BIQUAD_EQ_RAMP_STEPS);
+
+    static_us = eq_two_core_run(false, false, &torn);
+    step_us = eq_two_core_run(false, true, &torn);
+    swaps = eq.swaps;
+    ramp_us = eq_two_core_run(true, true, &torn);
+    printf("[EQ] Core 1 filtering while core 0 retunes: %llu kiloSamples per second untouched, %llu stepped (%lu swaps), %llu ramped (%lu swaps).\n",
+           bench_kilo_per_second(samples, static_us), bench_kilo_per_second(samples, step_us), (unsigned long)swaps,
+           bench_kilo_per_second(samples, ramp_us), (unsigned long)eq.swaps);
+    if(torn != 0u)
+    {
+        printf("[EQ] ERROR: %lu blocks ran with coefficients that were not a published set.\n", (unsigned long)torn);
+    }
+}
+
+void core1_main(void)
+{
+    signal_generate(SIGNAL_CHIRP, core1_in, ARRAY_SIZE);
+    core_buffers[1] = (bench_buffers){ .in = core1_in, .out = core1_out, .length = ARRAY_SIZE };
+    bench_core1_loop();
 }
 
 int main(void)
@@ -61,33 +1473,44 @@ int main(void)
     stdio_usb_init();
     multicore_launch_core1(core1_main);
 
-    absolute_time_t start_time;
-    size_t duration_ms;
-    volatile int16_t in[ARRAY_SIZE];
-    volatile int16_t out[ARRAY_SIZE];
-    int16_t z1, z2;
-    int16_t outTemp;
-    int16_t inTemp;
     uint64_t counter = 1;
 
-    while(1) 
+    for(size_t i = 0; i < BIQUAD_MAX_SECTIONS; i++)
     {
-        start_time = get_absolute_time();
-        for(size_t loop_var = 0u; loop_var < ITERATIONS; loop_var++)
+        cascade_coeffs[i] = highpass_coeffs;
+    }
+    signal_generate(SIGNAL_CHIRP, core0_in, ARRAY_SIZE);
+    fft_init();
+    core_buffers[0] = (bench_buffers){ .in = core0_in, .out = core0_out, .length = ARRAY_SIZE };
+    while(1)
+    {
+        printf("[Core #0] Beginning run #%llu.\n", counter);
+        /* A kernel that fails its golden check would still run fast, so nothing is timed until they all pass. */
+        if(verify_biquad_kernels(0) != 0u)
         {
-            for(size_t i = 0; i < ARRAY_SIZE; i++)
-            {
-                inTemp = in[i];
-                outTemp = inTemp * a0 + z1;
-                z1 = inTemp * a1 + z2 - b1 * outTemp;
-                z2 = inTemp * a2 - b2 * outTemp;
-                out[i] = outTemp;
-            }
+            printf("[Core #0] ERROR! Skipping run #%llu's benchmarks until every kernel matches its signatures.\n", counter);
+            sleep_ms(VERIFY_RETRY_MS);
+            counter = counter + 1;
+            continue;
         }
-        duration_ms = absolute_time_diff_us(start_time, get_absolute_time()) / 1000;
-        printf("[Core #0] Finished iteration #%llu.\n", counter);
-        printf("[Core #0] Finished %u samples in %zu milliseconds.\n", ARRAY_SIZE * ITERATIONS, duration_ms);
-        printf("[Core #0] %zu kiloSamples per second.\n", ARRAY_SIZE * ITERATIONS / duration_ms);
+        bench_run_on_both_cores(cascade_job);
+        bench_run_on_both_cores(block_size_job);
+        bench_run_on_both_cores(layout_job);
+        bench_run_on_both_cores(swar_job);
+        bench_run_on_both_cores(fir_job);
+        bench_run_on_both_cores(topology_job);
+        bench_run_on_both_cores(asm_job);
+        bench_run_on_both_cores(precision_job);
+        bench_run_on_both_cores(design_job);
+        bench_run_on_both_cores(realtime_job);
+        biquad_pipeline_benchmark(ITERATIONS);
+        biquad_latency_benchmark();
+        biquad_eq_benchmark();
+        biquad_lookahead_benchmark(ITERATIONS);
+        fft_benchmark();
+        goertzel_benchmark();
+        biquad_live_benchmark();
+        biquad_placement_benchmark();
         counter = counter + 1;
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,123 @@
+#include        <stdint.h>
+
+#include        "pico/platform.h"
+#include        "pico/stdlib.h"
+#include        "pico/time.h"
+
+#include        "realtime.h"
+
+#define         CORE1_ALARM_NUM         2u
+#define         CORE1_ALARM_TIMERS      4u
+#define         SEARCH_TRIAL_MS         100u
+#define         SEARCH_MIN_BLOCKS       16u
+#define         SEARCH_RESOLUTION       1000u      /* stop once the bracket is within 1 kHz */
+
+typedef struct realtime_run_s
+{
+    realtime_block_fn process;
+    void* context;
+    size_t block_count;
+    uint64_t period_us;
+    absolute_time_t first_tick;
+    uint64_t busy_us;
+    uint64_t worst_us;
+    uint64_t missed;
+    volatile size_t handled;
+} realtime_run_state;
+
+/* Core 0 uses the SDK's default pool; core 1 needs its own so its alarm IRQ lands on core 1. */
+static alarm_pool_t* core_alarm_pool(void)
+{
+    static alarm_pool_t* core1_pool;
+
+    if(get_core_num() == 0u)
+    {
+        return alarm_pool_get_default();
+    }
+    if(core1_pool == NULL)
+    {
+        core1_pool = alarm_pool_create(CORE1_ALARM_NUM, CORE1_ALARM_TIMERS);
+    }
+    return core1_pool;
+}
+
+static bool realtime_tick(repeating_timer_t* rt)
+{
+    realtime_run_state* run = rt->user_data;
+    size_t block = run->handled;
+    absolute_time_t start_time = get_absolute_time();
+    absolute_time_t deadline;
+    uint64_t duration_us;
+
+    if(block == 0u)
+    {
+        run->first_tick = start_time;
+    }
+    run->process(run->context, block);
+    duration_us = absolute_time_diff_us(start_time, get_absolute_time());
+
+    /* Block N arrives with tick N and has to be done before tick N+1, however late its own tick fired. */
+    deadline = delayed_by_us(run->first_tick, (block + 1u) * run->period_us);
+    if(absolute_time_diff_us(deadline, get_absolute_time()) > 0)
+    {
+        run->missed = run->missed + 1u;
+    }
+    run->busy_us = run->busy_us + duration_us;
+    run->worst_us = (duration_us > run->worst_us) ? duration_us : run->worst_us;
+    run->handled = block + 1u;
+    return run->handled < run->block_count;
+}
+
+bool realtime_run(uint32_t sample_rate, size_t block_size, size_t block_count, realtime_block_fn process, void* context,
+                  realtime_report* report)
+{
+    realtime_run_state run = { .process = process, .context = context, .block_count = block_count };
+    repeating_timer_t timer;
+
+    run.period_us = ((uint64_t)block_size * 1000000u) / sample_rate;
+    if((run.period_us == 0u) || (block_count == 0u))
+    {
+        return false;
+    }
+    /* Negative delay: the period runs from one callback start to the next, i.e. a fixed sample clock. */
+    if(!alarm_pool_add_repeating_timer_us(core_alarm_pool(), -(int64_t)run.period_us, realtime_tick, &run, &timer))
+    {
+        return false;
+    }
+    while(run.handled < block_count)
+    {
+        tight_loop_contents();
+    }
+    cancel_repeating_timer(&timer);
+
+    report->sample_rate = (uint32_t)(((uint64_t)block_size * 1000000u) / run.period_us);
+    report->blocks = run.handled;
+    report->missed_deadlines = run.missed;
+    report->worst_handler_us = run.worst_us;
+    report->headroom_percent = 100 - (int32_t)((run.busy_us * 100u) / (run.handled * run.period_us));
+    return true;
+}
+
+uint32_t realtime_search_max_rate(uint32_t low_rate, uint32_t high_rate, size_t block_size, realtime_block_fn process, void* context)
+{
+    uint32_t best_rate = 0u;
+
+    while((low_rate <= high_rate) && ((high_rate - low_rate) >= SEARCH_RESOLUTION))
+    {
+        uint32_t rate = low_rate + ((high_rate - low_rate) / 2u);
+        size_t block_count = ((uint64_t)rate * SEARCH_TRIAL_MS) / (1000u * block_size);
+        realtime_report report;
+
+        block_count = (block_count < SEARCH_MIN_BLOCKS) ? SEARCH_MIN_BLOCKS : block_count;
+        if(realtime_run(rate, block_size, block_count, process, context, &report) && (report.missed_deadlines == 0u))
+        {
+            best_rate = report.sample_rate;
+            low_rate = rate + 1u;
+        }
+        else
+        {
+            high_rate = rate - 1u;
+        }
+    }
+    return best_rate;
+}
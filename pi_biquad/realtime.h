@@ -0,0 +1,28 @@
+#ifndef         _REALTIME_H
+#define         _REALTIME_H
+
+#include        <stdbool.h>
+#include        <stddef.h>
+#include        <stdint.h>
+
+/* Processes block number block_index, called from the sample clock's alarm handler. */
+typedef void (*realtime_block_fn)(void* context, size_t block_index);
+
+typedef struct realtime_report_s
+{
+    uint32_t sample_rate;           /* achieved, after rounding the block period to whole microseconds */
+    uint64_t blocks;
+    uint64_t missed_deadlines;      /* blocks not finished before the next block was due */
+    uint64_t worst_handler_us;
+    int32_t headroom_percent;       /* share of the block period left idle, negative when overloaded */
+} realtime_report;
+
+/* Runs block_count blocks at sample_rate on the calling core's alarm pool and waits for them. Returns false if the
+ * timer could not be started. */
+bool realtime_run(uint32_t sample_rate, size_t block_size, size_t block_count, realtime_block_fn process, void* context,
+                  realtime_report* report);
+
+/* Binary-searches [low_rate, high_rate] for the highest sample rate that runs without a missed deadline. */
+uint32_t realtime_search_max_rate(uint32_t low_rate, uint32_t high_rate, size_t block_size, realtime_block_fn process, void* context);
+
+#endif
@@ -0,0 +1,73 @@
+#include        <stdint.h>
+
+#include        "pico/platform.h"
+#include        "pico/stdlib.h"
+#include        "pico/time.h"
+
+#include        "sample_source.h"
+#include        "sample_source_port.h"
+
+/* The DMA writes straight into these and the filter reads them where they are. */
+static int16_t __attribute__((aligned(4))) ping_pong[2u][SAMPLE_SOURCE_MAX_BLOCK];
+static volatile uint32_t blocks_completed;
+
+bool sample_source_run(const sample_source_config* config, size_t block_count, sample_source_block_fn process, void* context,
+                       sample_source_report* report)
+{
+    int16_t* const buffers[2u] = { ping_pong[0u], ping_pong[1u] };
+    uint32_t handled = 0u;
+    uint64_t busy_us = 0u;
+    uint64_t overruns = 0u;
+    uint64_t processed = 0u;
+    absolute_time_t start_time;
+    uint64_t duration_us;
+    uint32_t filled;
+
+    if((config->block_length == 0u) || (config->block_length > SAMPLE_SOURCE_MAX_BLOCK) || (config->sample_rate == 0u) ||
+       (config->sample_rate > SAMPLE_SOURCE_MAX_RATE) || (config->input_mask == 0u) || (config->input_mask > 0x1Fu) || (block_count == 0u))
+    {
+        return false;
+    }
+    blocks_completed = 0u;
+    if(!sample_source_start(config, buffers, &blocks_completed))
+    {
+        return false;
+    }
+    start_time = get_absolute_time();
+    while(handled < block_count)
+    {
+        uint32_t completed;
+        absolute_time_t block_start;
+
+        while((completed = blocks_completed) == handled)
+        {
+            tight_loop_contents();
+        }
+        /* With two halves, anything more than one block behind has already been written over; skip to the newest. */
+        if((completed - handled) > 1u)
+        {
+            overruns = overruns + (completed - handled - 1u);
+            handled = completed - 1u;
+        }
+        block_start = get_absolute_time();
+        process(context, buffers[handled & 1u], config->block_length);
+        busy_us = busy_us + absolute_time_diff_us(block_start, get_absolute_time());
+        processed = processed + 1u;
+        /* Two blocks on means the DMA has started on this half again, under the filter. */
+        if((blocks_completed - handled) >= 2u)
+        {
+            overruns = overruns + 1u;
+        }
+        handled = handled + 1u;
+    }
+    duration_us = absolute_time_diff_us(start_time, get_absolute_time());
+    filled = blocks_completed;
+    sample_source_stop();
+
+    duration_us = (duration_us > 0u) ? duration_us : 1u;
+    report->sample_rate = (uint32_t)(((uint64_t)filled * config->block_length * 1000000u) / duration_us);
+    report->blocks = processed;
+    report->overruns = overruns;
+    report->utilisation_percent = (int32_t)((busy_us * 100u) / duration_us);
+    return true;
+}
@@ -0,0 +1,41 @@
+#ifndef         _SAMPLE_SOURCE_H
+#define         _SAMPLE_SOURCE_H
+
+#include        <stdbool.h>
+#include        <stddef.h>
+#include        <stdint.h>
+
+/* A live sample stream delivered a block at a time into two ping-pong buffers. On the board the ADC free-runs and
+ * two chained DMA channels fill the halves in turn; the host build streams a file at the same rate instead. Samples
+ * are the ADC's unsigned 12-bit codes on both, so a highpass in front of the filter takes out the mid-scale offset. */
+#define         SAMPLE_SOURCE_MAX_BLOCK     1024u
+#define         SAMPLE_SOURCE_MAX_RATE      500000u     /* the ADC's 96-cycle conversion at 48 MHz */
+#define         SAMPLE_SOURCE_MIDSCALE      2048
+
+typedef struct sample_source_config_s
+{
+    uint32_t sample_rate;       /* total over all inputs in input_mask */
+    uint32_t input_mask;        /* ADC inputs 0-4, sampled round robin when more than one is set */
+    size_t block_length;
+    const char* path;           /* host only: a 16-bit PCM WAV or raw little-endian file, NULL or unreadable plays a chirp */
+} sample_source_config;
+
+/* Called on the core that started the source with the half the DMA just finished. The block is the DMA target
+ * itself and may be filtered in place. The DMA does not wait for it: the chained channels start on this half again
+ * one block period after it was delivered, whether or not this has returned. */
+typedef void (*sample_source_block_fn)(void* context, int16_t* block, size_t length);
+
+typedef struct sample_source_report_s
+{
+    uint32_t sample_rate;       /* measured over the whole run */
+    uint64_t blocks;            /* handed to the filter */
+    uint64_t overruns;          /* blocks the DMA overwrote before or while the filter had them */
+    int32_t utilisation_percent;    /* share of the run spent in the filter */
+} sample_source_report;
+
+/* Streams block_count blocks through process and stops the source. Returns false if the configuration is out of
+ * range or the source could not be started. */
+bool sample_source_run(const sample_source_config* config, size_t block_count, sample_source_block_fn process, void* context,
+                       sample_source_report* report);
+
+#endif
@@ -0,0 +1,181 @@
+#include        <stdint.h>
+#include        <stdio.h>
+#include        <string.h>
+
+#include        "pico/stdlib.h"
+#include        "pico/time.h"
+
+#include        "sample_source.h"
+#include        "sample_source_port.h"
+#include        "signal.h"
+
+#define         CHIRP_LOOP          16384u
+#define         WAV_HEADER_BYTES    12u
+#define         WAV_CHUNK_BYTES     8u
+#define         WAV_PCM             1u
+
+/* Host stand-in for the ADC and DMA: a fixed-rate timer plays the part of the DMA completion interrupt and copies
+ * the next block of the file into the idle half, as 12-bit codes like the ADC's. */
+typedef struct host_source_s
+{
+    FILE* file;
+    long data_start;
+    long data_bytes;
+    long data_read;
+    int16_t chirp[CHIRP_LOOP];
+    size_t chirp_position;
+    int16_t* buffers[2u];
+    size_t block_length;
+    volatile uint32_t* completed;
+    repeating_timer_t timer;
+} host_source;
+
+static host_source source;
+
+static uint32_t read_le32(const uint8_t* bytes)
+{
+    return (uint32_t)bytes[0u] | ((uint32_t)bytes[1u] << 8u) | ((uint32_t)bytes[2u] << 16u) | ((uint32_t)bytes[3u] << 24u);
+}
+
+static uint16_t read_le16(const uint8_t* bytes)
+{
+    return (uint16_t)(bytes[0u] | (bytes[1u] << 8u));
+}
+
+/* Finds the sample data: the data chunk of a 16-bit PCM WAV, or the whole file when it has no RIFF header. */
+static bool open_samples(const char* path)
+{
+    uint8_t header[WAV_HEADER_BYTES];
+
+    source.file = fopen(path, "rb");
+    if(source.file == NULL)
+    {
+        return false;
+    }
+    if((fread(header, 1u, WAV_HEADER_BYTES, source.file) != WAV_HEADER_BYTES) || (memcmp(header, "RIFF", 4u) != 0) ||
+       (memcmp(header + 8u, "WAVE", 4u) != 0))
+    {
+        fseek(source.file, 0, SEEK_END);
+        source.data_start = 0;
+        source.data_bytes = ftell(source.file);
+        return source.data_bytes >= 2;
+    }
+    while(1)
+    {
+        uint8_t chunk[WAV_CHUNK_BYTES];
+        uint8_t format[16u];
+        long chunk_bytes;
+
+        if(fread(chunk, 1u, WAV_CHUNK_BYTES, source.file) != WAV_CHUNK_BYTES)
+        {
+            return false;
+        }
+        chunk_bytes = (long)read_le32(chunk + 4u);
+        if(memcmp(chunk, "data", 4u) == 0)
+        {
+            source.data_start = ftell(source.file);
+            source.data_bytes = chunk_bytes;
+            return source.data_bytes >= 2;
+        }
+        if(memcmp(chunk, "fmt ", 4u) == 0)
+        {
+            if((chunk_bytes < 16) || (fread(format, 1u, sizeof(format), source.file) != sizeof(format)) ||
+               (read_le16(format) != WAV_PCM) || (read_le16(format + 14u) != 16u))
+            {
+                return false;
+            }
+            chunk_bytes = chunk_bytes - 16;
+        }
+        /* Chunks are padded to an even length. */
+        fseek(source.file, chunk_bytes + (chunk_bytes & 1), SEEK_CUR);
+    }
+}
+
+static int16_t next_sample(void)
+{
+    uint8_t bytes[2u];
+
+    if(source.file == NULL)
+    {
+        int16_t sample = source.chirp[source.chirp_position];
+
+        source.chirp_position = (source.chirp_position + 1u) % CHIRP_LOOP;
+        return sample;
+    }
+    /* Loops the file, a stray odd byte at the end included. */
+    if(((source.data_read + 2) > source.data_bytes) || (fread(bytes, 1u, 2u, source.file) != 2u))
+    {
+        fseek(source.file, source.data_start, SEEK_SET);
+        source.data_read = 0;
+        if(fread(bytes, 1u, 2u, source.file) != 2u)
+        {
+            return 0;
+        }
+    }
+    source.data_read = source.data_read + 2;
+    return (int16_t)read_le16(bytes);
+}
+
+static bool host_source_tick(repeating_timer_t* rt)
+{
+    int16_t* block = source.buffers[*source.completed & 1u];
+
+    (void)rt;
+    for(size_t i = 0; i < source.block_length; i++)
+    {
+        block[i] = (int16_t)((next_sample() >> 4) + SAMPLE_SOURCE_MIDSCALE);
+    }
+    *source.completed = *source.completed + 1u;
+    return true;
+}
+
+bool sample_source_start(const sample_source_config* config, int16_t* const buffers[2u], volatile uint32_t* completed)
+{
+    uint64_t period_us = ((uint64_t)config->block_length * 1000000u) / config->sample_rate;
+
+    if(period_us == 0u)
+    {
+        return false;
+    }
+    source.file = NULL;
+    source.data_read = 0;
+    if((config->path != NULL) && !open_samples(config->path))
+    {
+        printf("[Source] Could not read %s as 16-bit PCM, playing a chirp instead.\n", config->path);
+        if(source.file != NULL)
+        {
+            fclose(source.file);
+            source.file = NULL;
+        }
+    }
+    if(source.file != NULL)
+    {
+        fseek(source.file, source.data_start, SEEK_SET);
+    }
+    else
+    {
+        signal_generate(SIGNAL_CHIRP, source.chirp, CHIRP_LOOP);
+        source.chirp_position = 0u;
+    }
+    source.buffers[0u] = buffers[0u];
+    source.buffers[1u] = buffers[1u];
+    source.block_length = config->block_length;
+    source.completed = completed;
+    /* Negative delay: a fixed sample clock, like the free-running ADC. */
+    if(!add_repeating_timer_us(-(int64_t)period_us, host_source_tick, NULL, &source.timer))
+    {
+        sample_source_stop();
+        return false;
+    }
+    return true;
+}
+
+void sample_source_stop(void)
+{
+    cancel_repeating_timer(&source.timer);
+    if(source.file != NULL)
+    {
+        fclose(source.file);
+        source.file = NULL;
+    }
+}
@@ -0,0 +1,15 @@
+#ifndef         _SAMPLE_SOURCE_PORT_H
+#define         _SAMPLE_SOURCE_PORT_H
+
+#include        <stdbool.h>
+#include        <stdint.h>
+
+#include        "sample_source.h"
+
+/* One per build: sample_source_rp2040.c on the board, sample_source_host.c on the host. The port fills buffers[0],
+ * buffers[1], buffers[0], ... with config->block_length samples each and bumps *completed as each one finishes,
+ * from its interrupt or timer context, without waiting for the consumer. */
+bool sample_source_start(const sample_source_config* config, int16_t* const buffers[2u], volatile uint32_t* completed);
+void sample_source_stop(void);
+
+#endif
@@ -0,0 +1,120 @@
+#include        <stdint.h>
+
+#include        "hardware/adc.h"
+#include        "hardware/dma.h"
+#include        "hardware/irq.h"
+#include        "pico/stdlib.h"
+
+#include        "sample_source.h"
+#include        "sample_source_port.h"
+
+#define         ADC_CLOCK_HZ        48000000u
+#define         ADC_FIRST_GPIO      26u
+#define         ADC_TEMP_INPUT      4u
+
+static int dma_channels[2u];
+static int16_t* dma_targets[2u];
+static volatile uint32_t* dma_completed;
+
+/* Each channel stops with its write address one block on, so it is pointed back at its half before the other
+ * channel's block ends and chains to it again. */
+static void __not_in_flash_func(sample_source_dma_irq)(void)
+{
+    for(uint loop_var = 0u; loop_var < 2u; loop_var++)
+    {
+        uint channel = (uint)dma_channels[loop_var];
+
+        if(dma_hw->ints0 & (1u << channel))
+        {
+            dma_hw->ints0 = 1u << channel;
+            dma_channel_set_write_addr(channel, dma_targets[loop_var], false);
+            *dma_completed = *dma_completed + 1u;
+        }
+    }
+}
+
+static void configure_channel(uint index, const sample_source_config* config)
+{
+    dma_channel_config dma_config = dma_channel_get_default_config((uint)dma_channels[index]);
+
+    channel_config_set_transfer_data_size(&dma_config, DMA_SIZE_16);
+    channel_config_set_read_increment(&dma_config, false);
+    channel_config_set_write_increment(&dma_config, true);
+    channel_config_set_dreq(&dma_config, DREQ_ADC);
+    channel_config_set_chain_to(&dma_config, (uint)dma_channels[index ^ 1u]);
+    dma_channel_configure((uint)dma_channels[index], &dma_config, dma_targets[index], &adc_hw->fifo, config->block_length, false);
+    dma_channel_set_irq0_enabled((uint)dma_channels[index], true);
+}
+
+bool sample_source_start(const sample_source_config* config, int16_t* const buffers[2u], volatile uint32_t* completed)
+{
+    uint first_input = 0u;
+
+    adc_init();
+    for(uint loop_var = 0u; loop_var <= ADC_TEMP_INPUT; loop_var++)
+    {
+        if(config->input_mask & (1u << loop_var))
+        {
+            if(loop_var == ADC_TEMP_INPUT)
+            {
+                adc_set_temp_sensor_enabled(true);
+            }
+            else
+            {
+                adc_gpio_init(ADC_FIRST_GPIO + loop_var);
+            }
+        }
+    }
+    while(!(config->input_mask & (1u << first_input)))
+    {
+        first_input = first_input + 1u;
+    }
+    adc_select_input(first_input);
+    adc_set_round_robin((config->input_mask & (config->input_mask - 1u)) ? config->input_mask : 0u);
+    /* Every sample is a DREQ, no error bit, full 12 bits. */
+    adc_fifo_setup(true, true, 1u, false, false);
+    /* A divider below the 96-cycle conversion time just runs the ADC back to back at its 500 kS/s. */
+    adc_set_clkdiv(((float)ADC_CLOCK_HZ / (float)config->sample_rate) - 1.0f);
+
+    dma_channels[0u] = dma_claim_unused_channel(true);
+    dma_channels[1u] = dma_claim_unused_channel(true);
+    dma_targets[0u] = buffers[0u];
+    dma_targets[1u] = buffers[1u];
+    dma_completed = completed;
+    configure_channel(0u, config);
+    configure_channel(1u, config);
+    irq_set_exclusive_handler(DMA_IRQ_0, sample_source_dma_irq);
+    irq_set_enabled(DMA_IRQ_0, true);
+
+    adc_fifo_drain();
+    dma_channel_start((uint)dma_channels[0u]);
+    adc_run(true);
+    return true;
+}
+
+void sample_source_stop(void)
+{
+    adc_run(false);
+    irq_set_enabled(DMA_IRQ_0, false);
+    for(uint loop_var = 0u; loop_var < 2u; loop_var++)
+    {
+        uint channel = (uint)dma_channels[loop_var];
+
+        /* Unchain first so aborting one channel does not start the other. */
+        dma_channel_set_irq0_enabled(channel, false);
+        hw_write_masked(&dma_hw->ch[channel].al1_ctrl, channel << DMA_CH0_CTRL_TRIG_CHAIN_TO_LSB, DMA_CH0_CTRL_TRIG_CHAIN_TO_BITS);
+    }
+    for(uint loop_var = 0u; loop_var < 2u; loop_var++)
+    {
+        uint channel = (uint)dma_channels[loop_var];
+
+        dma_channel_abort(channel);
+        dma_hw->ints0 = 1u << channel;
+        dma_channel_unclaim(channel);
+    }
+    irq_remove_handler(DMA_IRQ_0, sample_source_dma_irq);
+    adc_fifo_setup(false, false, 0u, false, false);
+    adc_fifo_drain();
+    adc_set_round_robin(0u);
+    adc_set_temp_sensor_enabled(false);
+}
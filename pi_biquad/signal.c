@@ -0,0 +1,63 @@
+#include        <stdint.h>
+#include        <string.h>
+
+#include        "signal.h"
+
+#define         CHIRP_START_STEP        0x00100000u     /* phase steps as a fraction of 2^32 per sample */
+#define         CHIRP_END_STEP          0x40000000u     /* a quarter of the sample rate */
+#define         LFSR_SEED               0xACE1u
+#define         LFSR_TAPS               0xB400u
+
+const char* const signal_names[SIGNAL_COUNT] = { "impulse", "chirp", "LFSR noise", "full-scale LFSR noise" };
+
+/* Parabolic sine with one correction step, Q15 out for a 16-bit phase covering one turn. */
+static int32_t sine_q15(uint16_t phase)
+{
+    int32_t x = (int16_t)phase;
+    int32_t abs_x = (x < 0) ? -x : x;
+    int32_t y = (x * (32768 - abs_x)) >> 13;
+    int32_t abs_y = (y < 0) ? -y : y;
+
+    y = y + ((225 * (((y * abs_y) >> 15) - y)) / 1000);
+    return (y > 32767) ? 32767 : ((y < -32767) ? -32767 : y);
+}
+
+void signal_generate(signal_type type, int16_t* out, size_t length)
+{
+    uint32_t phase = 0u;
+    uint16_t lfsr = LFSR_SEED;
+
+    switch(type)
+    {
+        case SIGNAL_IMPULSE:
+            memset(out, 0, length * sizeof(int16_t));
+            if(length > 0u)
+            {
+                out[0] = SIGNAL_AMPLITUDE;
+            }
+            break;
+        case SIGNAL_CHIRP:
+            /* Linear sweep, the phase step grows by the same amount every sample. */
+            for(size_t i = 0u; i < length; i++)
+            {
+                out[i] = (int16_t)((sine_q15(phase >> 16u) * SIGNAL_AMPLITUDE) >> 15);
+                phase = phase + CHIRP_START_STEP + (uint32_t)(((uint64_t)(CHIRP_END_STEP - CHIRP_START_STEP) * i) / length);
+            }
+            break;
+        case SIGNAL_NOISE_FULL:
+            /* Binary noise, the output bit picks plus or minus full scale. Its +-+ runs take the highpass sum past 32 bits. */
+            for(size_t i = 0u; i < length; i++)
+            {
+                lfsr = (lfsr >> 1u) ^ ((uint16_t)(-(int16_t)(lfsr & 1u)) & LFSR_TAPS);
+                out[i] = ((lfsr & 1u) != 0u) ? INT16_MAX : -INT16_MAX;
+            }
+            break;
+        default:
+            for(size_t i = 0u; i < length; i++)
+            {
+                lfsr = (lfsr >> 1u) ^ ((uint16_t)(-(int16_t)(lfsr & 1u)) & LFSR_TAPS);
+                out[i] = (int16_t)((int16_t)lfsr >> 1);
+            }
+            break;
+    }
+}
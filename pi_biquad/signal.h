@@ -0,0 +1,25 @@
+#ifndef         _SIGNAL_H
+#define         _SIGNAL_H
+
+#include        <stddef.h>
+#include        <stdint.h>
+
+/* Deterministic test inputs, integer-only so every platform produces the same samples. All but the last stay within
+ * half scale, which keeps the Q14 sums clear of saturation. The full-scale noise covers the whole int16 range, to drive
+ * the kernels through their saturating and widest accumulator paths. */
+typedef enum signal_type_e
+{
+    SIGNAL_IMPULSE = 0,
+    SIGNAL_CHIRP,
+    SIGNAL_NOISE,
+    SIGNAL_NOISE_FULL,
+    SIGNAL_COUNT
+} signal_type;
+
+#define         SIGNAL_AMPLITUDE        16384
+
+extern const char* const signal_names[SIGNAL_COUNT];
+
+void signal_generate(signal_type type, int16_t* out, size_t length);
+
+#endif
@@ -0,0 +1,352 @@
+#include        <stdbool.h>
+#include        <stdint.h>
+#include        <stdio.h>
+#include        <string.h>
+
+#include        "biquad.h"
+#include        "biquad_asm.h"
+#include        "biquad_design.h"
+#include        "biquad_multichannel.h"
+#include        "biquad_precision.h"
+#include        "biquad_swar.h"
+#include        "signal.h"
+#include        "verify.h"
+
+#define         VERIFY_CHANNELS         3u      /* one pair plus the odd channel the multichannel kernels handle alone */
+
+typedef bool (*verify_kernel)(const biquad_coeffs* coeffs, const int16_t* in, int16_t* out, size_t length);
+
+typedef struct verify_variant_s
+{
+    const char* name;
+    verify_kernel run;
+    const verify_signature* known;
+} verify_variant;
+
+/* Outputs of the highpass + 1 kHz lowpass cascade for each signal in signal.h order. TDF2 and DF1 saturate the same
+ * exact 64-bit sum, so every variant of them must reproduce the Q14 table bit for bit. */
+static const verify_signature q14_known[SIGNAL_COUNT] =
+{
+    { 0x6171u, 0x69f8659eu },
+    { 0x91a2u, 0x0dbf8e37u },
+    { 0x5991u, 0xb3cd94b2u },
+    { 0xe698u, 0xa6763586u },
+};
+
+/* The Thumb-1 kernel wraps its 32-bit sum where the others saturate (see biquad_asm.h), so it only agrees with the
+ * Q14 table on the in-range signals. */
+static const verify_signature asm_known[SIGNAL_COUNT] =
+{
+    { 0x6171u, 0x69f8659eu },
+    { 0x91a2u, 0x0dbf8e37u },
+    { 0x5991u, 0xb3cd94b2u },
+    { 0x3c30u, 0xb7aca667u },
+};
+
+static const verify_signature df2_known[SIGNAL_COUNT] =
+{
+    { 0xe378u, 0x5beebf88u },
+    { 0xe4b5u, 0x2b39d6c1u },
+    { 0x01fbu, 0xaf990537u },
+    { 0xf97eu, 0xeb1832bau },
+};
+
+static const verify_signature q31_known[SIGNAL_COUNT] =
+{
+    { 0xa75bu, 0x64b6dbbfu },
+    { 0x5bffu, 0x6b5e0269u },
+    { 0x6cbcu, 0x34747339u },
+    { 0x2f29u, 0xf38d3c4cu },
+};
+
+/* The cascade rows run whichever section kernel BIQUAD_TOPOLOGY selects. */
+#if BIQUAD_TOPOLOGY == BIQUAD_TOPOLOGY_DF2
+#define         CASCADE_KNOWN           df2_known
+#else
+#define         CASCADE_KNOWN           q14_known
+#endif
+
+static int16_t verify_in[VERIFY_LENGTH];
+static int16_t verify_out[VERIFY_LENGTH];
+static int16_t verify_reference[VERIFY_LENGTH];
+/* Each multichannel or packed kernel needs its own layout, but only one runs at a time. */
+static union
+{
+    int16_t frames[VERIFY_LENGTH * VERIFY_CHANNELS];
+    int16_t planes[VERIFY_CHANNELS][VERIFY_LENGTH];
+    uint32_t words[VERIFY_LENGTH];
+} verify_scratch;
+
+static uint16_t crcu8(uint8_t data, uint16_t crc)
+{
+    for(uint8_t i = 0u; i < 8u; i++)
+    {
+        uint16_t carry = (uint16_t)((data ^ crc) & 1u);
+
+        data = data >> 1u;
+        crc = (uint16_t)(crc >> 1u);
+        crc = carry ? (uint16_t)(crc ^ 0xA001u) : crc;
+    }
+    return crc;
+}
+
+uint16_t verify_crc16(const int16_t* data, size_t length, uint16_t crc)
+{
+    for(size_t i = 0u; i < length; i++)
+    {
+        crc = crcu8((uint8_t)data[i], crc);
+        crc = crcu8((uint8_t)((uint16_t)data[i] >> 8u), crc);
+    }
+    return crc;
+}
+
+uint32_t verify_crc32(const int16_t* data, size_t length, uint32_t crc)
+{
+    crc = ~crc;
+    for(size_t i = 0u; i < length; i++)
+    {
+        crc = crc ^ (uint16_t)data[i];
+        for(uint8_t bit = 0u; bit < 16u; bit++)
+        {
+            crc = (crc >> 1u) ^ (0xEDB88320u & (uint32_t)(-(int32_t)(crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+static bool cascade_kernel(const biquad_coeffs* coeffs, const int16_t* in, int16_t* out, size_t length)
+{
+    biquad_state state;
+
+    biquad_state_init(&state, coeffs, VERIFY_SECTIONS);
+    biquad_process_block(&state, in, out, length);
+    return true;
+}
+
+/* An odd block size, so blocks never line up with anything the kernels might unroll by. */
+static bool streamed_kernel(const biquad_coeffs* coeffs, const int16_t* in, int16_t* out, size_t length)
+{
+    biquad_state state;
+
+    biquad_state_init(&state, coeffs, VERIFY_SECTIONS);
+    for(size_t offset = 0u; offset < length; offset = offset + 37u)
+    {
+        biquad_process_block(&state, in + offset, out + offset, ((length - offset) < 37u) ? (length - offset) : 37u);
+    }
+    return true;
+}
+
+static bool in_place_kernel(const biquad_coeffs* coeffs, const int16_t* in, int16_t* out, size_t length)
+{
+    memcpy(out, in, length * sizeof(int16_t));
+    return cascade_kernel(coeffs, out, out, length);
+}
+
+static bool section_kernel(void (*process)(const biquad_coeffs*, int32_t*, const int16_t*, int16_t*, size_t),
+                           const biquad_coeffs* coeffs, const int16_t* in, int16_t* out, size_t length)
+{
+    int32_t state[BIQUAD_STATE_WORDS];
+
+    for(size_t section = 0u; section < VERIFY_SECTIONS; section++)
+    {
+        memset(state, 0, sizeof(state));
+        process(&coeffs[section], state, (section == 0u) ? in : out, out, length);
+    }
+    return true;
+}
+
+static bool df1_kernel(const biquad_coeffs* coeffs, const int16_t* in, int16_t* out, size_t length)
+{
+    return section_kernel(biquad_df1_process, coeffs, in, out, length);
+}
+
+static bool asm_kernel(const biquad_coeffs* coeffs, const int16_t* in, int16_t* out, size_t length)
+{
+    return section_kernel(biquad_asm_process, coeffs, in, out, length);
+}
+
+static bool df2_kernel(const biquad_coeffs* coeffs, const int16_t* in, int16_t* out, size_t length)
+{
+    return section_kernel(biquad_df2_process, coeffs, in, out, length);
+}
+
+static bool tdf2_kernel(const biquad_coeffs* coeffs, const int16_t* in, int16_t* out, size_t length)
+{
+    return section_kernel(biquad_tdf2_process, coeffs, in, out, length);
+}
+
+static bool q31_kernel(const biquad_coeffs* coeffs, const int16_t* in, int16_t* out, size_t length)
+{
+    biquad_q31_section section;
+
+    for(size_t loop_var = 0u; loop_var < VERIFY_SECTIONS; loop_var++)
+    {
+        biquad_q31_init(&section, &coeffs[loop_var]);
+        biquad_q31_process(&section, (loop_var == 0u) ? in : out, out, length);
+    }
+    return true;
+}
+
+/* Every channel carries the same signal, so each must come out identical to channel 0, which is returned. */
+static bool interleaved_kernel(const biquad_coeffs* coeffs, const int16_t* in, int16_t* out, size_t length)
+{
+    biquad_multichannel state;
+
+    for(size_t i = 0u; i < length; i++)
+    {
+        for(size_t channel = 0u; channel < VERIFY_CHANNELS; channel++)
+        {
+            verify_scratch.frames[(i * VERIFY_CHANNELS) + channel] = in[i];
+        }
+    }
+    biquad_multichannel_init(&state, coeffs, VERIFY_SECTIONS, VERIFY_CHANNELS);
+    biquad_process_interleaved(&state, verify_scratch.frames, verify_scratch.frames, length);
+    for(size_t i = 0u; i < length; i++)
+    {
+        out[i] = verify_scratch.frames[i * VERIFY_CHANNELS];
+        for(size_t channel = 1u; channel < VERIFY_CHANNELS; channel++)
+        {
+            if(verify_scratch.frames[(i * VERIFY_CHANNELS) + channel] != out[i])
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static bool planar_kernel(const biquad_coeffs* coeffs, const int16_t* in, int16_t* out, size_t length)
+{
+    biquad_multichannel state;
+    const int16_t* planes_in[VERIFY_CHANNELS];
+    int16_t* planes_out[VERIFY_CHANNELS];
+
+    for(size_t channel = 0u; channel < VERIFY_CHANNELS; channel++)
+    {
+        memcpy(verify_scratch.planes[channel], in, length * sizeof(int16_t));
+        planes_in[channel] = verify_scratch.planes[channel];
+        planes_out[channel] = verify_scratch.planes[channel];
+    }
+    biquad_multichannel_init(&state, coeffs, VERIFY_SECTIONS, VERIFY_CHANNELS);
+    biquad_process_planar(&state, planes_in, planes_out, length);
+    memcpy(out, verify_scratch.planes[0], length * sizeof(int16_t));
+    for(size_t channel = 1u; channel < VERIFY_CHANNELS; channel++)
+    {
+        if(memcmp(verify_scratch.planes[channel], out, length * sizeof(int16_t)) != 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Both lanes carry the signal, so any bleed between them shows up as a lane mismatch. */
+static bool swar_kernel(const biquad_coeffs* coeffs, const int16_t* in, int16_t* out, size_t length)
+{
+    biquad_swar_section sections[VERIFY_SECTIONS];
+    bool consistent = true;
+
+    for(size_t section = 0u; section < VERIFY_SECTIONS; section++)
+    {
+        biquad_swar_init(&sections[section], &coeffs[section]);
+    }
+    for(size_t i = 0u; i < length; i++)
+    {
+        verify_scratch.words[i] = biquad_swar_pack(in[i], in[i]);
+    }
+    biquad_swar_process(sections, VERIFY_SECTIONS, verify_scratch.words, verify_scratch.words, length);
+    for(size_t i = 0u; i < length; i++)
+    {
+        out[i] = biquad_swar_left(verify_scratch.words[i]);
+        consistent = consistent && (biquad_swar_right(verify_scratch.words[i]) == out[i]);
+    }
+    return consistent;
+}
+
+/* The first entry is the reference the others are compared against when locating a bad block. */
+static const verify_variant verify_variants[] =
+{
+    { "cascade",                cascade_kernel,         CASCADE_KNOWN },
+    { "streamed cascade",       streamed_kernel,        CASCADE_KNOWN },
+    { "in-place cascade",       in_place_kernel,        CASCADE_KNOWN },
+    { "TDF2 sections",          tdf2_kernel,            q14_known },
+    { "DF1 sections",           df1_kernel,             q14_known },
+    { "Thumb-1 DF1 sections",   asm_kernel,             asm_known },
+    { "DF2 sections",           df2_kernel,             df2_known },
+    { "Q31 sections",           q31_kernel,             q31_known },
+    { "interleaved x3",         interleaved_kernel,     q14_known },
+    { "planar x3",              planar_kernel,          q14_known },
+    { "packed stereo",          swar_kernel,            q14_known },
+};
+
+static size_t first_bad_block(const int16_t* out, const int16_t* reference, size_t length)
+{
+    for(size_t block = 0u; (block * VERIFY_BLOCK) < length; block++)
+    {
+        if(verify_crc32(out + (block * VERIFY_BLOCK), VERIFY_BLOCK, 0u) != verify_crc32(reference + (block * VERIFY_BLOCK), VERIFY_BLOCK, 0u))
+        {
+            return block;
+        }
+    }
+    return length / VERIFY_BLOCK;
+}
+
+size_t verify_biquad_kernels(int core_number)
+{
+    biquad_coeffs coeffs[VERIFY_SECTIONS];
+    size_t variant_count = sizeof(verify_variants) / sizeof(verify_variants[0]);
+    size_t errors = 0u;
+
+    /* The original highpass followed by the designed 1 kHz lowpass. */
+    coeffs[0] = (biquad_coeffs){ .a0 = 16384, .a1 = -32768, .a2 = 16384, .b1 = -25576, .b2 = 10508 };
+    coeffs[1] = biquad_design_presets[0].coeffs;
+
+    for(size_t signal = 0u; signal < SIGNAL_COUNT; signal++)
+    {
+        signal_generate((signal_type)signal, verify_in, VERIFY_LENGTH);
+        for(size_t variant = 0u; variant < variant_count; variant++)
+        {
+            const verify_variant* current = &verify_variants[variant];
+            const verify_signature* known = &current->known[signal];
+            uint16_t crc16 = 0u;
+            uint32_t crc32 = 0u;
+            bool consistent = current->run(coeffs, verify_in, verify_out, VERIFY_LENGTH);
+
+            for(size_t offset = 0u; offset < VERIFY_LENGTH; offset = offset + VERIFY_BLOCK)
+            {
+                crc16 = verify_crc16(verify_out + offset, VERIFY_BLOCK, crc16);
+                crc32 = verify_crc32(verify_out + offset, VERIFY_BLOCK, crc32);
+            }
+            if(variant == 0u)
+            {
+                memcpy(verify_reference, verify_out, sizeof(verify_reference));
+            }
+            if(!consistent)
+            {
+                printf("[Core #%d] ERROR! %s, %s: channels disagree.\n", core_number, current->name, signal_names[signal]);
+                errors = errors + 1u;
+            }
+            if((crc16 != known->crc16) || (crc32 != known->crc32))
+            {
+                printf("[Core #%d] ERROR! %s, %s: crc16 0x%04x crc32 0x%08lx - should be 0x%04x 0x%08lx", core_number, current->name,
+                       signal_names[signal], crc16, (unsigned long)crc32, known->crc16, (unsigned long)known->crc32);
+                if((current->known == verify_variants[0].known) && (first_bad_block(verify_out, verify_reference, VERIFY_LENGTH) < (VERIFY_LENGTH / VERIFY_BLOCK)))
+                {
+                    printf(", first bad block %zu", first_bad_block(verify_out, verify_reference, VERIFY_LENGTH));
+                }
+                printf(".\n");
+                errors = errors + 1u;
+            }
+        }
+    }
+
+    if(errors == 0u)
+    {
+        printf("[Core #%d] Golden outputs: %zu kernel variants x %u signals match their signatures.\n", core_number, variant_count, SIGNAL_COUNT);
+    }
+    else
+    {
+        printf("[Core #%d] Golden outputs: %zu mismatches, this run's results are not valid.\n", core_number, errors);
+    }
+    return errors;
+}
@@ -0,0 +1,28 @@
+#ifndef         _VERIFY_H
+#define         _VERIFY_H
+
+#include        <stddef.h>
+#include        <stdint.h>
+
+#include        "signal.h"
+
+/* Golden-output check: every kernel variant filters each test signal through the same cascade, and the CRCs of
+ * its output are compared against known signatures. An optimised variant is only trusted once its signatures match. */
+#define         VERIFY_LENGTH           1024u
+#define         VERIFY_BLOCK            64u     /* CRCs are chained block by block, so a mismatch can be located */
+#define         VERIFY_SECTIONS         2u
+
+typedef struct verify_signature_s
+{
+    uint16_t crc16;
+    uint32_t crc32;
+} verify_signature;
+
+/* crc16 follows picoremark's crcu16, crc32 is the reflected IEEE 802.3 polynomial. Both can be chained across calls. */
+uint16_t verify_crc16(const int16_t* data, size_t length, uint16_t crc);
+uint32_t verify_crc32(const int16_t* data, size_t length, uint32_t crc);
+
+/* Runs every registered variant against every signal and returns the number of mismatches. */
+size_t verify_biquad_kernels(int core_number);
+
+#endif
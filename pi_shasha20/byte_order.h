@@ -0,0 +1,17 @@
+#ifndef         _BYTE_ORDER_H
+#define         _BYTE_ORDER_H
+
+#include        <stddef.h>
+#include        <stdint.h>
+
+/* Rotates, and byte-at-a-time loads and stores so buffers need no alignment and the host's byte order doesn't matter. */
+#define     U32_LEFT_ROTATE(input, dist)        (((input) << dist) | ((input) >> (32u - dist)))
+#define     U32_RIGHT_ROTATE(input, dist)       (((input) >> dist) | ((input) << (32u - dist)))
+#define     LOAD_U32_BE(buffer)                 ((uint32_t)(buffer)[3u] | ((uint32_t)(buffer)[2u] << 8u) | ((uint32_t)(buffer)[1u] << 16u) | ((uint32_t)(buffer)[0u] << 24u))
+#define     LOAD_U32_LE(buffer)                 ((uint32_t)(buffer)[0u] | ((uint32_t)(buffer)[1u] << 8u) | ((uint32_t)(buffer)[2u] << 16u) | ((uint32_t)(buffer)[3u] << 24u))
+#define     STORE_U32_BE(buffer, input)         for(size_t macro_loop_var = 0u; macro_loop_var < 4u; macro_loop_var++)\
+                                                {\
+                                                    (buffer)[macro_loop_var] = (input) >> (8u * (3u - macro_loop_var));\
+                                                }
+
+#endif
@@ -0,0 +1,226 @@
+#include        <stdbool.h>
+#include        <stddef.h>
+#include        <stdint.h>
+#include        <string.h>
+
+#include        "hardware/sync.h"
+#include        "pico/multicore.h"
+#include        "pico/platform.h"
+
+#include        "byte_order.h"
+#include        "chacha20.h"
+
+#define     CHACHA20_QUARTER_ROUND(a, b, c, d)  a += b; \
+                                                d = U32_LEFT_ROTATE(d ^ a, 16u); \
+                                                c += d; \
+                                                b = U32_LEFT_ROTATE(b ^ c, 12u); \
+                                                a += b; \
+                                                d = U32_LEFT_ROTATE(d ^ a,  8u); \
+                                                c += d; \
+                                                b = U32_LEFT_ROTATE(b ^ c,  7u)
+
+#define         CHACHA20_WORKER_STOP    0xFFFFFFFFu     /* never a block count: buffers stay far below 2^32 blocks */
+
+/* Core 1's range: the block count and first counter go over the FIFO, the rest is published here first. The
+ * fences around the FIFO order state and data; only done is polled, so only it is volatile. */
+typedef struct chacha20_work_s
+{
+    uint32_t state[16u];
+    uint8_t* data;
+    volatile bool done;
+} chacha20_work;
+
+static chacha20_work work;
+
+void chacha20_init(chacha20_context* context, const uint8_t* key, const uint8_t* nonce, uint32_t counter)
+{
+    context->state[0u] = LOAD_U32_LE("expa");
+    context->state[1u] = LOAD_U32_LE("nd 3");
+    context->state[2u] = LOAD_U32_LE("2-by");
+    context->state[3u] = LOAD_U32_LE("te k");
+    for(size_t loop_var = 0u; loop_var < 8u; loop_var++)
+    {
+        context->state[4u + loop_var] = LOAD_U32_LE(key + (4u * loop_var));
+    }
+    for(size_t loop_var = 0u; loop_var < 3u; loop_var++)
+    {
+        context->state[13u + loop_var] = LOAD_U32_LE(nonce + (4u * loop_var));
+    }
+    chacha20_seek(context, counter);
+}
+
+void chacha20_seek(chacha20_context* context, uint32_t counter)
+{
+    context->state[CHACHA20_COUNTER_WORD] = counter;
+    context->keystream_used = CHACHA20_BLOCK_BYTES;
+    context->exhausted = false;
+}
+
+void chacha20_block(const uint32_t* state, uint32_t* keystream)
+{
+    memcpy(keystream, state, sizeof(uint32_t) * 16u);
+
+    for (size_t loop_var = 0u; loop_var < 10u; loop_var++) /* 20 rounds, 2 rounds per loop. */
+    {
+        CHACHA20_QUARTER_ROUND(keystream[0u], keystream[4u], keystream[8u], keystream[12u]);     /* column 0 */
+        CHACHA20_QUARTER_ROUND(keystream[1u], keystream[5u], keystream[9u], keystream[13u]);     /* column 1 */
+        CHACHA20_QUARTER_ROUND(keystream[2u], keystream[6u], keystream[10u], keystream[14u]);    /* column 2 */
+        CHACHA20_QUARTER_ROUND(keystream[3u], keystream[7u], keystream[11u], keystream[15u]);    /* column 3 */
+        CHACHA20_QUARTER_ROUND(keystream[0u], keystream[5u], keystream[10u], keystream[15u]);    /* diagonal 0 */
+        CHACHA20_QUARTER_ROUND(keystream[1u], keystream[6u], keystream[11u], keystream[12u]);    /* diagonal 1 */
+        CHACHA20_QUARTER_ROUND(keystream[2u], keystream[7u], keystream[8u], keystream[13u]);     /* diagonal 2 */
+        CHACHA20_QUARTER_ROUND(keystream[3u], keystream[4u], keystream[9u], keystream[14u]);     /* diagonal 3 */
+    }
+
+    for(size_t loop_var = 0u; loop_var < 16u; loop_var++) /* adding original block to scrambled block */
+    {
+        keystream[loop_var] = keystream[loop_var] + state[loop_var];
+    }
+}
+
+/* Whole blocks a word at a time when the data is word aligned. The keystream is little-endian, which on the
+ * M0+ and little-endian hosts is the words' own byte order; anything else goes a byte at a time. */
+static void xor_block(uint8_t* data, const uint32_t* keystream)
+{
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    if(((uintptr_t)data & 3u) == 0u)
+    {
+        uint8_t* aligned = __builtin_assume_aligned(data, 4u);
+
+        for(size_t loop_var = 0u; loop_var < 16u; loop_var++)
+        {
+            uint32_t word;
+
+            memcpy(&word, aligned + (4u * loop_var), sizeof(word));
+            word = word ^ keystream[loop_var];
+            memcpy(aligned + (4u * loop_var), &word, sizeof(word));
+        }
+        return;
+    }
+#endif
+    for(size_t loop_var = 0u; loop_var < CHACHA20_BLOCK_BYTES; loop_var++)
+    {
+        data[loop_var] = data[loop_var] ^ (uint8_t)(keystream[loop_var / 4u] >> (8u * (loop_var % 4u)));
+    }
+}
+
+static void xor_partial(chacha20_context* context, uint8_t* data, size_t length)
+{
+    for(size_t loop_var = 0u; loop_var < length; loop_var++)
+    {
+        size_t position = context->keystream_used + loop_var;
+
+        data[loop_var] = data[loop_var] ^ (uint8_t)(context->keystream[position / 4u] >> (8u * (position % 4u)));
+    }
+    context->keystream_used = context->keystream_used + length;
+}
+
+/* The next block's keystream, unless the counter has run out. */
+static bool next_keystream(chacha20_context* context)
+{
+    if(context->exhausted)
+    {
+        return false;
+    }
+    chacha20_block(context->state, context->keystream);
+    context->state[CHACHA20_COUNTER_WORD]++;
+    context->exhausted = (context->state[CHACHA20_COUNTER_WORD] == 0u);
+    return true;
+}
+
+bool chacha20_xor(chacha20_context* context, uint8_t* data, size_t length)
+{
+    size_t left = CHACHA20_BLOCK_BYTES - context->keystream_used;
+
+    /* Finish the block a previous call started. */
+    if(left != 0u)
+    {
+        size_t count = (length < left) ? length : left;
+
+        xor_partial(context, data, count);
+        data = data + count;
+        length = length - count;
+    }
+    for(; length >= CHACHA20_BLOCK_BYTES; length = length - CHACHA20_BLOCK_BYTES)
+    {
+        if(!next_keystream(context))
+        {
+            return false;
+        }
+        xor_block(data, context->keystream);
+        data = data + CHACHA20_BLOCK_BYTES;
+    }
+    if(length != 0u)
+    {
+        if(!next_keystream(context))
+        {
+            return false;
+        }
+        context->keystream_used = 0u;
+        xor_partial(context, data, length);
+    }
+    return true;
+}
+
+bool chacha20_xor_dual(chacha20_context* context, uint8_t* data, size_t length)
+{
+    size_t left = CHACHA20_BLOCK_BYTES - context->keystream_used;
+    size_t lead = (length < left) ? length : left;
+    size_t blocks = (length - lead) / CHACHA20_BLOCK_BYTES;
+    size_t own_blocks = blocks / 2u;
+    uint32_t first_counter;
+
+    /* Splits that would reach the end of the counter stay on core 0, which stops there. */
+    if((blocks < CHACHA20_DUAL_MIN_BLOCKS) || context->exhausted ||
+       (((uint64_t)context->state[CHACHA20_COUNTER_WORD] + blocks) > ((uint64_t)UINT32_MAX + 1u)))
+    {
+        return chacha20_xor(context, data, length);
+    }
+    /* Finishing a started block leaves the stream on a block boundary, where the counter alone says where it is. */
+    chacha20_xor(context, data, lead);
+    data = data + lead;
+    length = length - lead;
+    first_counter = context->state[CHACHA20_COUNTER_WORD];
+
+    memcpy(work.state, context->state, sizeof(context->state));
+    work.data = data + (own_blocks * CHACHA20_BLOCK_BYTES);
+    work.done = false;
+    __mem_fence_release();
+    multicore_fifo_push_blocking((uint32_t)(blocks - own_blocks));
+    multicore_fifo_push_blocking(first_counter + (uint32_t)own_blocks);
+
+    chacha20_xor(context, data, own_blocks * CHACHA20_BLOCK_BYTES);
+    while(!work.done)
+    {
+        tight_loop_contents();
+    }
+    __mem_fence_acquire();
+
+    /* Core 1's blocks are done, so the stream carries on after them with any tail. */
+    chacha20_seek(context, first_counter + (uint32_t)blocks);
+    context->exhausted = (((uint64_t)first_counter + blocks) > UINT32_MAX);
+    return chacha20_xor(context, data + (blocks * CHACHA20_BLOCK_BYTES), length - (blocks * CHACHA20_BLOCK_BYTES));
+}
+
+void chacha20_worker(void)
+{
+    uint32_t blocks;
+
+    while((blocks = multicore_fifo_pop_blocking()) != CHACHA20_WORKER_STOP)
+    {
+        uint32_t counter = multicore_fifo_pop_blocking();
+        chacha20_context range;
+
+        __mem_fence_acquire();
+        memcpy(range.state, work.state, sizeof(range.state));
+        chacha20_seek(&range, counter);
+        chacha20_xor(&range, work.data, (size_t)blocks * CHACHA20_BLOCK_BYTES);
+        __mem_fence_release();
+        work.done = true;
+    }
+}
+
+void chacha20_stop(void)
+{
+    multicore_fifo_push_blocking(CHACHA20_WORKER_STOP);
+}
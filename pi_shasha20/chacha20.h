@@ -0,0 +1,47 @@
+#ifndef         _CHACHA20_H
+#define         _CHACHA20_H
+
+#include        <stdbool.h>
+#include        <stddef.h>
+#include        <stdint.h>
+
+/* RFC 8439 ChaCha20: 256-bit key, 96-bit nonce, 32-bit block counter. Encrypting and decrypting are the same XOR. */
+#define         CHACHA20_KEY_BYTES      32u
+#define         CHACHA20_NONCE_BYTES    12u
+#define         CHACHA20_BLOCK_BYTES    64u
+#define         CHACHA20_COUNTER_WORD   12u
+
+typedef struct chacha20_context_s
+{
+    uint32_t state[16u];                        /* constants, key, counter of the next block, nonce */
+    uint32_t keystream[16u];                    /* the block XOR is part way through */
+    size_t keystream_used;                      /* bytes of it already used, CHACHA20_BLOCK_BYTES when none is left */
+    bool exhausted;                             /* the counter came round past block 2^32 - 1 */
+} chacha20_context;
+
+/* The stream starts at block counter; RFC 8439 encryption starts at 1, leaving block 0 for the Poly1305 key. */
+void chacha20_init(chacha20_context* context, const uint8_t* key, const uint8_t* nonce, uint32_t counter);
+
+/* Moves the stream to the start of block counter, e.g. to decrypt from the middle of a message. */
+void chacha20_seek(chacha20_context* context, uint32_t counter);
+
+/* XORs the keystream into length bytes in place, carrying on from where the last call stopped. RFC 8439 gives one
+ * nonce 2^32 blocks (256 GiB); past block 2^32 - 1 the counter would come round to keystream already used, so this
+ * returns false instead, with data partly encrypted, until a seek. */
+bool chacha20_xor(chacha20_context* context, uint8_t* data, size_t length);
+
+/* Both cores over one buffer, split by block counter: core 0 keeps the first half of the whole blocks and core 1
+ * gets the rest. Core 1 must be inside chacha20_worker. Output and the context afterwards are exactly those of
+ * chacha20_xor; buffers under CHACHA20_DUAL_MIN_BLOCKS blocks stay on core 0. */
+#define         CHACHA20_DUAL_MIN_BLOCKS    2u
+
+bool chacha20_xor_dual(chacha20_context* context, uint8_t* data, size_t length);
+
+/* Core 1's side: takes block ranges from the FIFO until chacha20_stop. */
+void chacha20_worker(void);
+void chacha20_stop(void);
+
+/* The raw block function: keystream for the counter and nonce in state, as sixteen little-endian words. */
+void chacha20_block(const uint32_t* state, uint32_t* keystream);
+
+#endif
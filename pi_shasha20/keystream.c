@@ -0,0 +1,168 @@
+#include        <stdbool.h>
+#include        <stddef.h>
+#include        <stdint.h>
+#include        <string.h>
+
+#include        "hardware/sync.h"
+#include        "pico/multicore.h"
+#include        "pico/platform.h"
+
+#include        "chacha20.h"
+#include        "keystream.h"
+
+#define         KEYSTREAM_TOKEN_RUN     0x4B535201u
+#define         KEYSTREAM_TOKEN_DONE    0x4B535202u
+#define         KEYSTREAM_TOKEN_END     0x4B535203u
+
+/* Only a token fits the FIFO, so the ring core 1 is to fill is published here first. */
+static keystream_ring* volatile active_ring;
+
+void keystream_ring_init(keystream_ring* ring, const uint8_t* key, const uint8_t* nonce, uint32_t counter)
+{
+    chacha20_context context;
+
+    chacha20_init(&context, key, nonce, counter);
+    memcpy(ring->state, context.state, sizeof(ring->state));
+    ring->produced = 0u;
+    ring->consumed = 0u;
+    ring->running = false;
+    ring->exhausted = false;
+    ring->used = 0u;
+    ring->stalls = 0u;
+}
+
+void keystream_ring_start(keystream_ring* ring)
+{
+    ring->running = true;
+    active_ring = ring;
+    __mem_fence_release();
+    multicore_fifo_push_blocking(KEYSTREAM_TOKEN_RUN);
+}
+
+void keystream_ring_stop(keystream_ring* ring)
+{
+    ring->running = false;
+    while(multicore_fifo_pop_blocking() != KEYSTREAM_TOKEN_DONE);
+}
+
+static void keystream_produce(keystream_ring* ring)
+{
+    while(ring->running)
+    {
+        uint32_t produced = ring->produced;
+        uint32_t* block = ring->blocks[produced % KEYSTREAM_RING_BLOCKS];
+
+        if(((produced - ring->consumed) == KEYSTREAM_RING_BLOCKS) || ring->exhausted)
+        {
+            tight_loop_contents();
+            continue;
+        }
+        /* Reading consumed above has to come before overwriting the slot core 0 just gave back. */
+        __mem_fence_acquire();
+        chacha20_block(ring->state, block);
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+        for(size_t loop_var = 0u; loop_var < 16u; loop_var++)
+        {
+            block[loop_var] = __builtin_bswap32(block[loop_var]);
+        }
+#endif
+        ring->state[CHACHA20_COUNTER_WORD]++;
+        __mem_fence_release();
+        ring->produced = produced + 1u;
+        /* Past 2^32 blocks the counter would come round to keystream already used. */
+        if(ring->state[CHACHA20_COUNTER_WORD] == 0u)
+        {
+            __mem_fence_release();
+            ring->exhausted = true;
+        }
+    }
+}
+
+void keystream_worker(void)
+{
+    uint32_t token;
+
+    while((token = multicore_fifo_pop_blocking()) != KEYSTREAM_TOKEN_END)
+    {
+        if(token == KEYSTREAM_TOKEN_RUN)
+        {
+            __mem_fence_acquire();
+            keystream_produce(active_ring);
+            multicore_fifo_push_blocking(KEYSTREAM_TOKEN_DONE);
+        }
+    }
+}
+
+void keystream_end(void)
+{
+    multicore_fifo_push_blocking(KEYSTREAM_TOKEN_END);
+}
+
+/* Word at a time when the packet and the keystream are at the same alignment, as they are for whole blocks of an
+ * aligned packet; the ring's bytes are already in stream order. */
+static void xor_bytes(uint8_t* data, const uint8_t* keystream, size_t length)
+{
+    size_t loop_var = 0u;
+
+    if((((uintptr_t)data | (uintptr_t)keystream) & 3u) == 0u)
+    {
+        for(; (loop_var + 4u) <= length; loop_var = loop_var + 4u)
+        {
+            uint32_t word;
+            uint32_t key;
+
+            memcpy(&word, data + loop_var, sizeof(word));
+            memcpy(&key, keystream + loop_var, sizeof(key));
+            word = word ^ key;
+            memcpy(data + loop_var, &word, sizeof(word));
+        }
+    }
+    for(; loop_var < length; loop_var++)
+    {
+        data[loop_var] = data[loop_var] ^ keystream[loop_var];
+    }
+}
+
+bool keystream_ring_xor(keystream_ring* ring, uint8_t* data, size_t length)
+{
+    bool waited = false;
+
+    while(length != 0u)
+    {
+        uint32_t consumed = ring->consumed;
+        size_t count = CHACHA20_BLOCK_BYTES - ring->used;
+
+        if(consumed == ring->produced)
+        {
+            /* exhausted is set after the last block is published, so read it first and look again. */
+            bool exhausted = ring->exhausted;
+
+            __mem_fence_acquire();
+            if(consumed == ring->produced)
+            {
+                if(exhausted)
+                {
+                    return false;
+                }
+                ring->stalls = ring->stalls + (waited ? 0u : 1u);
+                waited = true;
+                tight_loop_contents();
+                continue;
+            }
+        }
+        __mem_fence_acquire();
+        count = (length < count) ? length : count;
+        xor_bytes(data, (const uint8_t*)ring->blocks[consumed % KEYSTREAM_RING_BLOCKS] + ring->used, count);
+        data = data + count;
+        length = length - count;
+        ring->used = ring->used + count;
+        if(ring->used == CHACHA20_BLOCK_BYTES)
+        {
+            ring->used = 0u;
+            /* Done reading the block before core 1 may write over it. */
+            __mem_fence_release();
+            ring->consumed = consumed + 1u;
+        }
+    }
+    return true;
+}
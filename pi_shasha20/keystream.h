@@ -0,0 +1,42 @@
+#ifndef         _KEYSTREAM_H
+#define         _KEYSTREAM_H
+
+#include        <stdbool.h>
+#include        <stddef.h>
+#include        <stdint.h>
+
+#include        "chacha20.h"
+
+/* ChaCha20 keystream made ahead of time by core 1 into a ring, so encrypting a packet on core 0 is only the XOR.
+ * Core 1 generates blocks in counter order and core 0 takes their bytes in the same order, handing a block back
+ * only once all 64 bytes are used, so no keystream byte is ever handed out twice. */
+#define         KEYSTREAM_RING_BLOCKS   32u     /* 2 KB ahead; a power of two so the counts may wrap */
+
+typedef struct keystream_ring_s
+{
+    uint32_t blocks[KEYSTREAM_RING_BLOCKS][16u];    /* in the stream's little-endian byte order */
+    uint32_t state[16u];                            /* core 1's: counter word is the next block to make */
+    volatile uint32_t produced;                     /* blocks made, only core 1 writes it */
+    volatile uint32_t consumed;                     /* blocks used up, only core 0 writes it */
+    volatile bool running;
+    volatile bool exhausted;                        /* the 32-bit counter ran out, nothing more will come */
+    size_t used;                                    /* core 0's: bytes taken from the oldest block */
+    uint32_t stalls;                                /* calls that had to wait for core 1 */
+} keystream_ring;
+
+/* Empty ring whose stream starts at block counter, as chacha20_init. Not while core 1 is producing into it. */
+void keystream_ring_init(keystream_ring* ring, const uint8_t* key, const uint8_t* nonce, uint32_t counter);
+
+/* Core 0: has core 1, waiting in keystream_worker, fill the ring until keystream_ring_stop. */
+void keystream_ring_start(keystream_ring* ring);
+void keystream_ring_stop(keystream_ring* ring);
+
+/* Core 0: XORs the next length bytes of keystream into data in place, waiting on core 1 if the ring runs dry.
+ * Returns false, with data partly encrypted, once the stream's counter is used up. */
+bool keystream_ring_xor(keystream_ring* ring, uint8_t* data, size_t length);
+
+/* Core 1's side: fills each ring it is started on until keystream_end. */
+void keystream_worker(void);
+void keystream_end(void);
+
+#endif
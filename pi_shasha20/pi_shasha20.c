@@ -1,7 +1,10 @@
+#include        <stdbool.h>
 #include        <stdint.h>
 #include        <stdio.h>
+#include        <stdlib.h>
 #include        <string.h>
 
+#include        "hardware/clocks.h"
 #include        "hardware/vreg.h"
 #include        "pico/stdio_usb.h"
 #include        "pico/stdlib.h"
@@ -9,217 +12,385 @@
 #include        "pico/time.h"
 #include        "pico/types.h"
 
+#include        "chacha20.h"
+#include        "keystream.h"
+#include        "sha256.h"
+#include        "verify.h"
+
 #define         LED_PIN         PICO_DEFAULT_LED_PIN
 #define         ITERATIONS      256
+#define         BUFFER_SIZE     65536U
+#define         PLACEMENT_SIZE  1024U   /* leaves the rest of the 4 KB scratch bank to the core's stack */
+#define         PLACEMENT_ITERATIONS    (ITERATIONS * (BUFFER_SIZE / PLACEMENT_SIZE))
+#define         STREAM_CHUNK    100U    /* deliberately not a multiple of the 64-byte block */
+#define         STREAM_DIVISOR  4U      /* the streamed pass hashes a quarter as much */
+#define         DUAL_MIN_SIZE   256U
+#define         DUAL_TOTAL      262144U /* bytes per buffer size and mode, so small sizes repeat more */
+#define         DUAL_PROBE      64U
+#define         PACKET_COUNT    4096U   /* back to back, for the sustained rate */
+#define         PACKET_PACED    1024U   /* one every PACKET_GAP_US, for the latency distribution */
+#define         PACKET_GAP_US   100U
+
+/* One buffer per core in static striped SRAM0-3; they used to sit on the 2 KB core stacks. */
+static uint8_t core0_buffer[BUFFER_SIZE];
+static uint8_t core1_buffer[BUFFER_SIZE];
+
+/* Small per-core blocks for the placement runs. The SDK keeps core 0's stack in SRAM5 (scratch Y) and core 1's in
+ * SRAM4 (scratch X), so each scratch block shares its bank only with its own core's stack. */
+static uint8_t core0_striped_block[PLACEMENT_SIZE];
+static uint8_t core1_striped_block[PLACEMENT_SIZE];
+static uint8_t __scratch_y("pi_shasha20") core0_scratch_block[PLACEMENT_SIZE];
+static uint8_t __scratch_x("pi_shasha20") core1_scratch_block[PLACEMENT_SIZE];
+
+/* A mix of packet sizes, mostly well under a block's worth of keystream generation. */
+static const size_t packet_sizes[] = { 40u, 64u, 120u, 200u, 256u, 576u };
+
+#define         PACKET_SIZE_COUNT   (sizeof(packet_sizes) / sizeof(packet_sizes[0u]))
+
+static keystream_ring packet_ring;
+static uint32_t packet_latencies_us[PACKET_PACED];
+
+static const uint8_t chacha20_nonce[CHACHA20_NONCE_BYTES] = { 'p', 'i', '_', 's', 'h', 'a', 's', 'h', 'a', '2', '0', 0u };
 
-#define     U32_LEFT_ROTATE(input, dist)        (((input) << dist) | ((input) >> (32u - dist)))
-#define     U32_RIGHT_ROTATE(input, dist)       (((input) >> dist) | ((input) << (32u - dist)))
-#define     LOAD_U32_BE(buffer)                 ((uint32_t)(buffer)[3u] | ((uint32_t)(buffer)[2u] << 8u) | ((uint32_t)(buffer)[1u] << 16u) | ((uint32_t)(buffer)[0u] << 24u))   
-#define     LOAD_U32_LE(buffer)                 ((uint32_t)(buffer)[0u] | ((uint32_t)(buffer)[1u] << 8u) | ((uint32_t)(buffer)[2u] << 16u) | ((uint32_t)(buffer)[3u] << 24u)) 
-#define     STORE_U32_BE(buffer, input)         for(size_t macro_loop_var = 0u; macro_loop_var < 4u; macro_loop_var++)\
-                                                {\
-                                                    (buffer)[macro_loop_var] = (input) >> (8u * (3u - macro_loop_var));\ 
-                                                }             
-#define     CHACHA20_QUARTER_ROUND(a, b, c, d)  a += b; \
-                                                d = U32_LEFT_ROTATE(d ^ a, 16u); \
-                                                c += d; \
-                                                b = U32_LEFT_ROTATE(b ^ c, 12u); \
-                                                a += b; \
-                                                d = U32_LEFT_ROTATE(d ^ a,  8u); \
-                                                c += d; \
-                                                b = U32_LEFT_ROTATE(b ^ c,  7u)
-
-static const uint32_t SHA256_constants[64u] =
-{   0x428a2f98u, 0x71374491u, 0xb5c0fbcfu, 0xe9b5dba5u, 0x3956c25bu, 0x59f111f1u, 0x923f82a4u, 0xab1c5ed5u,
-    0xd807aa98u, 0x12835b01u, 0x243185beu, 0x550c7dc3u, 0x72be5d74u, 0x80deb1feu, 0x9bdc06a7u, 0xc19bf174u,
-    0xe49b69c1u, 0xefbe4786u, 0x0fc19dc6u, 0x240ca1ccu, 0x2de92c6fu, 0x4a7484aau, 0x5cb0a9dcu, 0x76f988dau,
-    0x983e5152u, 0xa831c66du, 0xb00327c8u, 0xbf597fc7u, 0xc6e00bf3u, 0xd5a79147u, 0x06ca6351u, 0x14292967u,
-    0x27b70a85u, 0x2e1b2138u, 0x4d2c6dfcu, 0x53380d13u, 0x650a7354u, 0x766a0abbu, 0x81c2c92eu, 0x92722c85u,
-    0xa2bfe8a1u, 0xa81a664bu, 0xc24b8b70u, 0xc76c51a3u, 0xd192e819u, 0xd6990624u, 0xf40e3585u, 0x106aa070u,
-    0x19a4c116u, 0x1e376c08u, 0x2748774cu, 0x34b0bcb5u, 0x391c0cb3u, 0x4ed8aa4au, 0x5b9cca4fu, 0x682e6ff3u,
-    0x748f82eeu, 0x78a5636fu, 0x84c87814u, 0x8cc70208u, 0x90befffau, 0xa4506cebu, 0xbef9a3f7u, 0xc67178f2u };
-
-static void SHA256_state_init(uint32_t* SHA256_output)
+static uint64_t tenths_of_cycles_per_byte(uint64_t bytes, uint64_t duration_us)
 {
-    SHA256_output[0u] = 0x6a09e667u;
-    SHA256_output[1u] = 0xbb67ae85u;
-    SHA256_output[2u] = 0x3c6ef372u;
-    SHA256_output[3u] = 0xa54ff53au;
-    SHA256_output[4u] = 0x510e527fu;
-    SHA256_output[5u] = 0x9b05688cu;
-    SHA256_output[6u] = 0x1f83d9abu;
-    SHA256_output[7u] = 0x5be0cd19u;
+    return ((uint64_t)(clock_get_hz(clk_sys) / 100000u) * duration_us) / bytes;
 }
 
-static void SHA256_block_processor(uint8_t* SHA256_working_buffer, uint32_t* SHA256_output)
+void shasha20_processor(uint8_t* buffer, size_t buffer_length, size_t iteration_count, int core_number)
 {
-    size_t loop_var;
-    uint32_t temp_vars[6u];
-    uint32_t round_hash_values[8u];
+    absolute_time_t start_time = get_absolute_time();
+    uint8_t SHA256_digest[SHA256_DIGEST_BYTES];
+    uint8_t SHA256_streamed_digest[SHA256_DIGEST_BYTES];
 
-    for(loop_var = 16u; loop_var < 64u; loop_var++)
+    for(size_t i = 0; i < iteration_count; i++)
     {
-        temp_vars[2u] = LOAD_U32_BE(SHA256_working_buffer + (4u * (loop_var - 15u)));
-        temp_vars[3u] = LOAD_U32_BE(SHA256_working_buffer + (4u * (loop_var - 2u)));
-        temp_vars[0u] = U32_RIGHT_ROTATE(temp_vars[2u], 7u) ^ U32_RIGHT_ROTATE(temp_vars[2u], 18u) ^ (temp_vars[2u] >> 3u);
-        temp_vars[1u] = U32_RIGHT_ROTATE(temp_vars[3u], 17u) ^ U32_RIGHT_ROTATE(temp_vars[3u], 19u) ^ (temp_vars[3u] >> 10u);
-        STORE_U32_BE(SHA256_working_buffer + (4u * loop_var), LOAD_U32_BE(SHA256_working_buffer + (4u * (loop_var - 16u))) + temp_vars[0u] + LOAD_U32_BE(SHA256_working_buffer + (4u * (loop_var - 7u))) + temp_vars[1u]);
+        SHA256_buffer(buffer, buffer_length, SHA256_digest);
     }
 
-    memcpy(round_hash_values, SHA256_output, sizeof(uint32_t) * 8);
+    uint64_t duration_us = absolute_time_diff_us(start_time, get_absolute_time());
+    size_t duration_ms = duration_us / 1000;
+    printf("[Core #%d] Finished %zu SHA256 iterations in %zu milliseconds.\n", core_number, iteration_count, duration_ms);
+    printf("[Core #%d] Speed: %zu kilobytes of SHA256 per second, %llu.%llu cycles per byte.\n", core_number, iteration_count * buffer_length / duration_ms,
+           tenths_of_cycles_per_byte(iteration_count * buffer_length, duration_us) / 10u, tenths_of_cycles_per_byte(iteration_count * buffer_length, duration_us) % 10u);
 
-    for(loop_var = 0u; loop_var < 64u; loop_var++)
+    /* The same buffer arriving in odd-sized pieces, so one block in every few straddles two updates and is copied. */
+    size_t stream_iterations = (iteration_count > STREAM_DIVISOR) ? (iteration_count / STREAM_DIVISOR) : 1u;
+    start_time = get_absolute_time();
+    for(size_t i = 0; i < stream_iterations; i++)
     {
-        temp_vars[0u] = U32_RIGHT_ROTATE(round_hash_values[4u], 6u) ^ U32_RIGHT_ROTATE(round_hash_values[4u], 11u) ^ U32_RIGHT_ROTATE(round_hash_values[4u], 25u);
-        temp_vars[1u] = (round_hash_values[4u] & round_hash_values[5u]) ^ (~(round_hash_values[4u]) & round_hash_values[6u]);
-        temp_vars[2u] = round_hash_values[7u] + temp_vars[0u] + temp_vars[1u] + SHA256_constants[loop_var] + LOAD_U32_BE(SHA256_working_buffer + (4u * loop_var));
-        temp_vars[3u] = U32_RIGHT_ROTATE(round_hash_values[0u], 2u) ^ U32_RIGHT_ROTATE(round_hash_values[0u], 13u) ^ U32_RIGHT_ROTATE(round_hash_values[0u], 22u);
-        temp_vars[4u] = (round_hash_values[0u] & round_hash_values[1u]) ^ (round_hash_values[0u] & round_hash_values[2u]) ^ (round_hash_values[1u] & round_hash_values[2u]);
-        temp_vars[5u] = temp_vars[3u] + temp_vars[4u];
+        SHA256_context context;
 
-        round_hash_values[7u] = round_hash_values[6u];
-        round_hash_values[6u] = round_hash_values[5u];
-        round_hash_values[5u] = round_hash_values[4u];
-        round_hash_values[4u] = round_hash_values[3u] + temp_vars[2u];
-        round_hash_values[3u] = round_hash_values[2u];
-        round_hash_values[2u] = round_hash_values[1u];
-        round_hash_values[1u] = round_hash_values[0u];
-        round_hash_values[0u] = temp_vars[2u] + temp_vars[5u];
+        SHA256_init(&context);
+        for(size_t j = 0; j < buffer_length; j = j + STREAM_CHUNK)
+        {
+            SHA256_update(&context, buffer + j, ((buffer_length - j) < STREAM_CHUNK) ? (buffer_length - j) : STREAM_CHUNK);
+        }
+        SHA256_final(&context, SHA256_streamed_digest);
+    }
+    duration_us = absolute_time_diff_us(start_time, get_absolute_time());
+    printf("[Core #%d] Streamed in %u-byte updates: %llu kilobytes of SHA256 per second.\n", core_number, STREAM_CHUNK,
+           ((uint64_t)stream_iterations * buffer_length * 1000u) / ((duration_us > 0u) ? duration_us : 1u));
+    if(memcmp(SHA256_digest, SHA256_streamed_digest, SHA256_DIGEST_BYTES) != 0)
+    {
+        printf("[Core #%d] ERROR! Streamed SHA256 digest differs from the one-shot digest.\n", core_number);
     }
 
-    for(loop_var = 0u; loop_var < 8u; loop_var++)
+    /* Real encryption in place, the digest as the key: keystream, XOR and the buffer's own memory traffic. */
+    chacha20_context chacha20;
+    chacha20_init(&chacha20, SHA256_digest, chacha20_nonce, 1u);
+    start_time = get_absolute_time();
+    for(size_t i = 0; i < iteration_count; i++)
     {
-        SHA256_output[loop_var] = SHA256_output[loop_var] + round_hash_values[loop_var];
+        chacha20_xor(&chacha20, buffer, buffer_length);
     }
+    duration_us = absolute_time_diff_us(start_time, get_absolute_time());
+    duration_ms = duration_us / 1000;
+    printf("[Core #%d] Finished %zu ChaCha20 iterations in %zu milliseconds.\n", core_number, iteration_count, duration_ms);
+    printf("[Core #%d] Speed: %zu kilobytes of ChaCha20 per second, %llu.%llu cycles per byte.\n", core_number, iteration_count * buffer_length / duration_ms,
+           tenths_of_cycles_per_byte(iteration_count * buffer_length, duration_us) / 10u, tenths_of_cycles_per_byte(iteration_count * buffer_length, duration_us) % 10u);
 }
 
-static void SHA256_eof_processor(uint8_t* SHA256_working_buffer, size_t read_bytes, uint32_t input_size, uint32_t* SHA256_output)
+static uint64_t hundredths_of_bytes_per_us(uint64_t bytes, uint64_t duration_us)
 {
-    if(read_bytes < 56u)
+    return (bytes * 100u) / ((duration_us > 0u) ? duration_us : 1u);
+}
+
+static uint64_t chacha20_time_us(chacha20_context* chacha20, uint8_t* buffer, size_t buffer_length, size_t iteration_count, bool dual)
+{
+    absolute_time_t start_time = get_absolute_time();
+
+    for(size_t i = 0; i < iteration_count; i++)
     {
-        SHA256_working_buffer[read_bytes++] = 0x80u;
-        for(; read_bytes < 60u; read_bytes++)
+        if(dual)
+        {
+            chacha20_xor_dual(chacha20, buffer, buffer_length);
+        }
+        else
         {
-            SHA256_working_buffer[read_bytes] = 0u;
+            chacha20_xor(chacha20, buffer, buffer_length);
         }
     }
-    else
+    return absolute_time_diff_us(start_time, get_absolute_time());
+}
+
+/* One stream split across both cores by block counter against the same stream on core 0 alone, from a few blocks up
+ * to the whole buffer. Core 1 has to be in chacha20_worker. */
+static void chacha20_scaling_benchmark(uint8_t* buffer)
+{
+    uint8_t digest_before[SHA256_DIGEST_BYTES];
+    uint8_t digest_after[SHA256_DIGEST_BYTES];
+    uint8_t single_probe[DUAL_PROBE] = { 0u };
+    uint8_t dual_probe[DUAL_PROBE] = { 0u };
+    chacha20_context single;
+    chacha20_context dual;
+    size_t crossover = 0u;
+
+    /* Encrypt on one core and decrypt on two from a mid-block start: the buffer comes back only if both produced the
+     * same keystream, and the contexts must agree on where the stream carries on. */
+    SHA256_buffer(buffer, BUFFER_SIZE, digest_before);
+    chacha20_init(&single, digest_before, chacha20_nonce, 1u);
+    chacha20_init(&dual, digest_before, chacha20_nonce, 1u);
+    chacha20_xor(&single, buffer, 5u);
+    chacha20_xor(&dual, buffer, 5u);
+    chacha20_xor(&single, buffer + 5u, BUFFER_SIZE - 24u);
+    chacha20_xor_dual(&dual, buffer + 5u, BUFFER_SIZE - 24u);
+    chacha20_xor(&single, buffer, 5u);
+    chacha20_xor(&dual, buffer, 5u);
+    chacha20_xor(&single, single_probe, DUAL_PROBE);
+    chacha20_xor(&dual, dual_probe, DUAL_PROBE);
+    SHA256_buffer(buffer, BUFFER_SIZE, digest_after);
+    if((memcmp(digest_before, digest_after, SHA256_DIGEST_BYTES) != 0) || (memcmp(single_probe, dual_probe, DUAL_PROBE) != 0))
     {
-        SHA256_working_buffer[read_bytes++] = 0x80u;
-        for(; read_bytes < 64u; read_bytes++)
+        printf("[Core #0] ERROR! Dual-core ChaCha20 differs from the single-core stream.\n");
+    }
+
+    printf("[Core #0] ChaCha20 on one core against both, split by block counter:\n");
+    for(size_t size = DUAL_MIN_SIZE; size <= BUFFER_SIZE; size = size * 2u)
+    {
+        size_t iteration_count = DUAL_TOTAL / size;
+        uint64_t single_us = chacha20_time_us(&single, buffer, size, iteration_count, false);
+        uint64_t dual_us = chacha20_time_us(&dual, buffer, size, iteration_count, true);
+        uint64_t bytes = (uint64_t)iteration_count * size;
+        uint64_t efficiency = (single_us * 50u) / ((dual_us > 0u) ? dual_us : 1u);
+
+        printf("[Core #0] %6zu bytes: one core %llu.%02llu MB/s, two cores %llu.%02llu MB/s, %llu%% of perfect scaling.\n", size,
+               hundredths_of_bytes_per_us(bytes, single_us) / 100u, hundredths_of_bytes_per_us(bytes, single_us) % 100u,
+               hundredths_of_bytes_per_us(bytes, dual_us) / 100u, hundredths_of_bytes_per_us(bytes, dual_us) % 100u, efficiency);
+        /* The crossover is the smallest size from which splitting keeps paying off. */
+        if(dual_us >= single_us)
         {
-            SHA256_working_buffer[read_bytes] = 0u;
+            crossover = 0u;
         }
-        SHA256_block_processor(SHA256_working_buffer, SHA256_output);
-
-        for(read_bytes = 0u; read_bytes < 60u; read_bytes++)
+        else if(crossover == 0u)
         {
-            SHA256_working_buffer[read_bytes] = 0u;
+            crossover = size;
         }
     }
-    
-    for(; read_bytes < 64u; read_bytes++)
+    if(crossover != 0u)
+    {
+        printf("[Core #0] Splitting pays off from %zu bytes up.\n", crossover);
+    }
+    else
     {
-        SHA256_working_buffer[read_bytes] = input_size >> (8u * (63u - read_bytes));
+        printf("[Core #0] Splitting did not pay off at any size up to %u bytes.\n", BUFFER_SIZE);
     }
-    SHA256_block_processor(SHA256_working_buffer, SHA256_output);
 }
 
-static void chacha20_state_block_init(uint32_t* chacha20_state_block, uint32_t* key)
+/* Packets laid end to end through the buffer, starting over at the front when the next one would not fit. */
+static size_t next_packet(size_t* offset, size_t packet)
 {
-    chacha20_state_block[0u] = LOAD_U32_LE("expa");
-    chacha20_state_block[1u] = LOAD_U32_LE("nd 3");
-    chacha20_state_block[2u] = LOAD_U32_LE("2-by");
-    chacha20_state_block[3u] = LOAD_U32_LE("te k");
-    memcpy(chacha20_state_block + 4u, key, sizeof(uint32_t) * 8u);
-    chacha20_state_block[14u] = LOAD_U32_LE("mist");
-    chacha20_state_block[15u] = LOAD_U32_LE("rake");
+    size_t size = packet_sizes[packet % PACKET_SIZE_COUNT];
+
+    *offset = ((*offset + size) > BUFFER_SIZE) ? 0u : *offset;
+    return size;
 }
 
-static void gen_chacha20_xor_block(uint32_t* chacha20_state_block, uint32_t* chacha20_xor_block, uint64_t block_counter)
+static int compare_latencies(const void* left, const void* right)
 {
-    chacha20_state_block[12u] = block_counter & 0xffffffffu;
-    chacha20_state_block[13u] = block_counter >> 32u;
+    uint32_t a = *(const uint32_t*)left;
+    uint32_t b = *(const uint32_t*)right;
 
-    memcpy(chacha20_xor_block, chacha20_state_block, sizeof(uint32_t) * 16u);
+    return (a > b) - (a < b);
+}
 
-    for (size_t loop_var = 0u; loop_var < 10u; loop_var++) /* 20 rounds, 2 rounds per loop. */
-    {
-        CHACHA20_QUARTER_ROUND(chacha20_xor_block[0u], chacha20_xor_block[4u], chacha20_xor_block[8u], chacha20_xor_block[12u]);    /* column 0 */
-        CHACHA20_QUARTER_ROUND(chacha20_xor_block[1u], chacha20_xor_block[5u], chacha20_xor_block[9u], chacha20_xor_block[13u]);    /* column 1 */
-        CHACHA20_QUARTER_ROUND(chacha20_xor_block[2u], chacha20_xor_block[6u], chacha20_xor_block[10u], chacha20_xor_block[14u]);   /* column 2 */
-        CHACHA20_QUARTER_ROUND(chacha20_xor_block[3u], chacha20_xor_block[7u], chacha20_xor_block[11u], chacha20_xor_block[15u]);   /* column 3 */
-        CHACHA20_QUARTER_ROUND(chacha20_xor_block[0u], chacha20_xor_block[5u], chacha20_xor_block[10u], chacha20_xor_block[15u]);   /* diagonal 0 */
-        CHACHA20_QUARTER_ROUND(chacha20_xor_block[1u], chacha20_xor_block[6u], chacha20_xor_block[11u], chacha20_xor_block[12u]);   /* diagonal 1 */
-        CHACHA20_QUARTER_ROUND(chacha20_xor_block[2u], chacha20_xor_block[7u], chacha20_xor_block[8u], chacha20_xor_block[13u]);    /* diagonal 2 */
-        CHACHA20_QUARTER_ROUND(chacha20_xor_block[3u], chacha20_xor_block[4u], chacha20_xor_block[9u], chacha20_xor_block[14u]);    /* diagonal 3 */                                
-    }
+/* Encrypts packets either with chacha20_xor, keystream made on the spot, or from the ring core 1 keeps topped up.
+ * Returns the time for packet_count packets; paced runs leave each packet's latency in packet_latencies_us. */
+static uint64_t packet_run(uint8_t* buffer, chacha20_context* chacha20, keystream_ring* ring, size_t packet_count, bool paced)
+{
+    absolute_time_t start_time = get_absolute_time();
+    absolute_time_t arrival = start_time;
+    size_t offset = 0u;
 
-    for(size_t loop_var = 0u; loop_var < 16u; loop_var++) /* adding original block to scrambled block */
+    for(size_t i = 0; i < packet_count; i++)
     {
-        chacha20_xor_block[loop_var] = chacha20_xor_block[loop_var] + chacha20_state_block[loop_var];
+        size_t size = next_packet(&offset, i);
+        uint64_t packet_start;
+
+        if(paced)
+        {
+            arrival = delayed_by_us(arrival, PACKET_GAP_US);
+            sleep_until(arrival);
+        }
+        packet_start = time_us_64();
+        if(ring != NULL)
+        {
+            if(!keystream_ring_xor(ring, buffer + offset, size))
+            {
+                printf("[Core #0] ERROR! The keystream ring ran out of counter.\n");
+                break;
+            }
+        }
+        else if(!chacha20_xor(chacha20, buffer + offset, size))
+        {
+            printf("[Core #0] ERROR! ChaCha20 ran out of counter.\n");
+            break;
+        }
+        if(paced)
+        {
+            packet_latencies_us[i] = (uint32_t)(time_us_64() - packet_start);
+        }
+        offset = offset + size;
     }
+    return absolute_time_diff_us(start_time, get_absolute_time());
 }
 
-void shasha20_processor(uint8_t* buffer, size_t buffer_length, size_t iteration_count, int core_number)
+static void packet_report(const char* mode, uint64_t burst_us)
 {
-    absolute_time_t start_time = get_absolute_time();
-    uint32_t SHA256_output[8];
-    uint8_t SHA256_working_buffer[256];
+    uint64_t total_us = 0u;
 
-    for(size_t i = 0; i < iteration_count; i++)
+    qsort(packet_latencies_us, PACKET_PACED, sizeof(packet_latencies_us[0u]), compare_latencies);
+    for(size_t i = 0; i < PACKET_PACED; i++)
     {
-        SHA256_state_init(SHA256_output);
-        for(size_t j = 0; j < (buffer_length / 64); j++)
-        {
-            memcpy(SHA256_working_buffer, buffer + (64 * j), 64);
-            SHA256_block_processor(SHA256_working_buffer, SHA256_output);
-        }
-        SHA256_eof_processor(SHA256_working_buffer, buffer_length % 64, buffer_length * 8, SHA256_output);
+        total_us = total_us + packet_latencies_us[i];
     }
+    printf("[Core #0] %s: latency mean %llu ns, p50 %lu us, p90 %lu us, p99 %lu us, max %lu us; %llu packets per second sustained.\n",
+           mode, (total_us * 1000u) / PACKET_PACED, packet_latencies_us[PACKET_PACED / 2u], packet_latencies_us[(PACKET_PACED * 90u) / 100u],
+           packet_latencies_us[(PACKET_PACED * 99u) / 100u], packet_latencies_us[PACKET_PACED - 1u],
+           ((uint64_t)PACKET_COUNT * 1000000u) / ((burst_us > 0u) ? burst_us : 1u));
+}
 
-    size_t duration_ms = absolute_time_diff_us(start_time, get_absolute_time()) / 1000;
-    printf("[Core #%d] Finished %zu SHA256 iterations in %zu milliseconds.\n", core_number, iteration_count, duration_ms);
-    printf("[Core #%d] Speed: %zu kilobytes of SHA256 per second.\n", core_number, iteration_count * buffer_length / duration_ms);
+/* Short packets with keystream made on the critical path against keystream core 1 made ahead of time. Core 1 has to
+ * be in keystream_worker. */
+static void packet_benchmark(uint8_t* buffer)
+{
+    uint8_t key[SHA256_DIGEST_BYTES];
+    uint8_t digest_before[SHA256_DIGEST_BYTES];
+    uint8_t digest_after[SHA256_DIGEST_BYTES];
+    chacha20_context chacha20;
+    uint64_t burst_us;
+    uint32_t paced_stalls;
+    size_t length = 0u;
 
-    start_time = get_absolute_time();
-    uint32_t chacha20_state_block[16u];
-    uint32_t chacha20_xor_block[16u];
-    uint64_t block_counter = 0u;
-    chacha20_state_block_init(chacha20_state_block, SHA256_output);
-    for(size_t i = 0; i < iteration_count; i++)
+    SHA256_buffer(buffer, BUFFER_SIZE, key);
+    chacha20_init(&chacha20, key, chacha20_nonce, 1u);
+    packet_run(buffer, &chacha20, NULL, PACKET_PACED, true);
+    burst_us = packet_run(buffer, &chacha20, NULL, PACKET_COUNT, false);
+    packet_report("Keystream per packet", burst_us);
+
+    /* Packets out of the ring must be exactly the stream in order: decrypting them as one run from the same counter
+     * brings the buffer back only if no keystream was skipped or used twice. */
+    SHA256_buffer(buffer, BUFFER_SIZE, digest_before);
+    keystream_ring_init(&packet_ring, key, chacha20_nonce, 1u);
+    keystream_ring_start(&packet_ring);
+    for(size_t i = 0; (length + packet_sizes[i % PACKET_SIZE_COUNT]) <= BUFFER_SIZE; i++)
     {
-        for(size_t j = 0; j < buffer_length; j = j + 64u)
-        {
-            gen_chacha20_xor_block(chacha20_state_block, chacha20_xor_block, block_counter);
-            block_counter = block_counter + 1;
-        }
+        keystream_ring_xor(&packet_ring, buffer + length, packet_sizes[i % PACKET_SIZE_COUNT]);
+        length = length + packet_sizes[i % PACKET_SIZE_COUNT];
+    }
+    chacha20_init(&chacha20, key, chacha20_nonce, 1u);
+    chacha20_xor(&chacha20, buffer, length);
+    SHA256_buffer(buffer, BUFFER_SIZE, digest_after);
+    if(memcmp(digest_before, digest_after, SHA256_DIGEST_BYTES) != 0)
+    {
+        printf("[Core #0] ERROR! Keystream from the ring differs from the ChaCha20 stream.\n");
     }
 
-    gen_chacha20_xor_block(chacha20_state_block, chacha20_xor_block, block_counter);
-    for(size_t i = 0; i < (buffer_length % 64u); i++)
+    /* Carry on from there, letting core 1 fill the ring before each run. */
+    packet_ring.stalls = 0u;
+    while((packet_ring.produced - packet_ring.consumed) != KEYSTREAM_RING_BLOCKS)
     {
-        buffer[((buffer_length / 64u) * 64u) + i] = buffer[((buffer_length / 64u) * 64u) + i] ^ (chacha20_xor_block[i / 4u] >> ((i % 4u) * 8u));
+        tight_loop_contents();
     }
-    duration_ms = absolute_time_diff_us(start_time, get_absolute_time()) / 1000;
-    printf("[Core #%d] Finished %zu ChaCha20 iterations in %zu milliseconds.\n", core_number, iteration_count, duration_ms);
-    printf("[Core #%d] Speed: %zu kilobytes of ChaCha20 per second.\n", core_number, iteration_count * buffer_length / duration_ms);
+    packet_run(buffer, NULL, &packet_ring, PACKET_PACED, true);
+    paced_stalls = packet_ring.stalls;
+    while((packet_ring.produced - packet_ring.consumed) != KEYSTREAM_RING_BLOCKS)
+    {
+        tight_loop_contents();
+    }
+    packet_ring.stalls = 0u;
+    burst_us = packet_run(buffer, NULL, &packet_ring, PACKET_COUNT, false);
+    keystream_ring_stop(&packet_ring);
+    packet_report("Keystream from core 1", burst_us);
+    printf("[Core #0] Waited on core 1: %lu of %u paced packets, %lu of %u back to back.\n", paced_stalls, PACKET_PACED,
+           packet_ring.stalls, PACKET_COUNT);
 }
 
-void core1_main(void)
+/* Both cores meet here before a timed run, so they contend for SRAM over the same stretch of time. */
+static void core_barrier(void)
+{
+    multicore_fifo_push_blocking(0u);
+    multicore_fifo_pop_blocking();
+}
+
+static void core_run(uint8_t* buffer, uint8_t* striped_block, uint8_t* scratch_block, int core_number)
 {
-    uint8_t buffer[65536];
     uint64_t counter = 1;
-    for(size_t i = 0; i < sizeof(buffer); i++)
+
+    for(size_t i = 0; i < BUFFER_SIZE; i++)
     {
         buffer[i] = i & 0xFF;
     }
+    memcpy(striped_block, buffer, PLACEMENT_SIZE);
+    memcpy(scratch_block, buffer, PLACEMENT_SIZE);
     while(1)
     {
-        printf("[Core #1] Beginning run #%llu.\n", counter);
-        shasha20_processor(buffer, sizeof(buffer), ITERATIONS, 1);
+        printf("[Core #%d] Beginning run #%llu.\n", core_number, counter);
+        if(core_number == 0)
+        {
+            verify_sha256(core_number);
+            verify_chacha20(core_number);
+        }
+        core_barrier();
+        shasha20_processor(buffer, BUFFER_SIZE, ITERATIONS, core_number);
+
+        printf("[Core #%d] %u-byte block in striped SRAM0-3:\n", core_number, PLACEMENT_SIZE);
+        core_barrier();
+        shasha20_processor(striped_block, PLACEMENT_SIZE, PLACEMENT_ITERATIONS, core_number);
+
+        printf("[Core #%d] %u-byte block in scratch SRAM%d:\n", core_number, PLACEMENT_SIZE, (core_number == 0) ? 5 : 4);
+        core_barrier();
+        shasha20_processor(scratch_block, PLACEMENT_SIZE, PLACEMENT_ITERATIONS, core_number);
+
+        /* Core 1 lends itself to core 0's buffer here rather than running its own. */
+        core_barrier();
+        if(core_number == 0)
+        {
+            chacha20_scaling_benchmark(buffer);
+            chacha20_stop();
+        }
+        else
+        {
+            chacha20_worker();
+        }
+
+        core_barrier();
+        if(core_number == 0)
+        {
+            packet_benchmark(buffer);
+            keystream_end();
+        }
+        else
+        {
+            keystream_worker();
+        }
         counter = counter + 1;
-    }   
+    }
+}
+
+void core1_main(void)
+{
+    core_run(core1_buffer, core1_striped_block, core1_scratch_block, 1);
 }
 
 int main(void)
@@ -237,16 +408,5 @@ int main(void)
 
     stdio_usb_init();
     multicore_launch_core1(core1_main);
-    uint64_t counter = 1;
-
-    uint8_t buffer[65536];
-    for(size_t i = 0; i < sizeof(buffer); i++)
-    {
-        buffer[i] = i & 0xFF;
-    }
-    while(1)
-    {
-        printf("[Core #0] Beginning run #%llu.\n", counter);
-        shasha20_processor(buffer, sizeof(buffer), ITERATIONS, 0);
-        counter = counter + 1;
-   }
\ No newline at end of file
+    core_run(core0_buffer, core0_striped_block, core0_scratch_block, 0);
+}
@@ -0,0 +1,166 @@
+#include        <stddef.h>
+#include        <stdint.h>
+#include        <string.h>
+
+#include        "byte_order.h"
+#include        "sha256.h"
+
+#define     SHA256_BIG_SIGMA0(x)                (U32_RIGHT_ROTATE(x, 2u) ^ U32_RIGHT_ROTATE(x, 13u) ^ U32_RIGHT_ROTATE(x, 22u))
+#define     SHA256_BIG_SIGMA1(x)                (U32_RIGHT_ROTATE(x, 6u) ^ U32_RIGHT_ROTATE(x, 11u) ^ U32_RIGHT_ROTATE(x, 25u))
+#define     SHA256_SMALL_SIGMA0(x)              (U32_RIGHT_ROTATE(x, 7u) ^ U32_RIGHT_ROTATE(x, 18u) ^ ((x) >> 3u))
+#define     SHA256_SMALL_SIGMA1(x)              (U32_RIGHT_ROTATE(x, 17u) ^ U32_RIGHT_ROTATE(x, 19u) ^ ((x) >> 10u))
+
+static const uint32_t SHA256_constants[64u] =
+{   0x428a2f98u, 0x71374491u, 0xb5c0fbcfu, 0xe9b5dba5u, 0x3956c25bu, 0x59f111f1u, 0x923f82a4u, 0xab1c5ed5u,
+    0xd807aa98u, 0x12835b01u, 0x243185beu, 0x550c7dc3u, 0x72be5d74u, 0x80deb1feu, 0x9bdc06a7u, 0xc19bf174u,
+    0xe49b69c1u, 0xefbe4786u, 0x0fc19dc6u, 0x240ca1ccu, 0x2de92c6fu, 0x4a7484aau, 0x5cb0a9dcu, 0x76f988dau,
+    0x983e5152u, 0xa831c66du, 0xb00327c8u, 0xbf597fc7u, 0xc6e00bf3u, 0xd5a79147u, 0x06ca6351u, 0x14292967u,
+    0x27b70a85u, 0x2e1b2138u, 0x4d2c6dfcu, 0x53380d13u, 0x650a7354u, 0x766a0abbu, 0x81c2c92eu, 0x92722c85u,
+    0xa2bfe8a1u, 0xa81a664bu, 0xc24b8b70u, 0xc76c51a3u, 0xd192e819u, 0xd6990624u, 0xf40e3585u, 0x106aa070u,
+    0x19a4c116u, 0x1e376c08u, 0x2748774cu, 0x34b0bcb5u, 0x391c0cb3u, 0x4ed8aa4au, 0x5b9cca4fu, 0x682e6ff3u,
+    0x748f82eeu, 0x78a5636fu, 0x84c87814u, 0x8cc70208u, 0x90befffau, 0xa4506cebu, 0xbef9a3f7u, 0xc67178f2u };
+
+static void SHA256_state_init(uint32_t* SHA256_output)
+{
+    SHA256_output[0u] = 0x6a09e667u;
+    SHA256_output[1u] = 0xbb67ae85u;
+    SHA256_output[2u] = 0x3c6ef372u;
+    SHA256_output[3u] = 0xa54ff53au;
+    SHA256_output[4u] = 0x510e527fu;
+    SHA256_output[5u] = 0x9b05688cu;
+    SHA256_output[6u] = 0x1f83d9abu;
+    SHA256_output[7u] = 0x5be0cd19u;
+}
+
+/* Sixteen rounds with the variables renamed instead of shifted along, so each round writes only d and h. WORD(i)
+ * gives round i's schedule word: straight from the block for the first sixteen rounds, expanded in place after. */
+#define     SHA256_ROUND(a, b, c, d, e, f, g, h, i, WORD)    round_temp = (h) + SHA256_BIG_SIGMA1(e) + (((e) & (f)) ^ (~(e) & (g))) + round_constants[i] + WORD(i); \
+                                                            (d) = (d) + round_temp; \
+                                                            (h) = round_temp + SHA256_BIG_SIGMA0(a) + (((a) & (b)) ^ ((a) & (c)) ^ ((b) & (c)))
+#define     SHA256_SIXTEEN_ROUNDS(WORD)         SHA256_ROUND(a, b, c, d, e, f, g, h,  0u, WORD); \
+                                                SHA256_ROUND(h, a, b, c, d, e, f, g,  1u, WORD); \
+                                                SHA256_ROUND(g, h, a, b, c, d, e, f,  2u, WORD); \
+                                                SHA256_ROUND(f, g, h, a, b, c, d, e,  3u, WORD); \
+                                                SHA256_ROUND(e, f, g, h, a, b, c, d,  4u, WORD); \
+                                                SHA256_ROUND(d, e, f, g, h, a, b, c,  5u, WORD); \
+                                                SHA256_ROUND(c, d, e, f, g, h, a, b,  6u, WORD); \
+                                                SHA256_ROUND(b, c, d, e, f, g, h, a,  7u, WORD); \
+                                                SHA256_ROUND(a, b, c, d, e, f, g, h,  8u, WORD); \
+                                                SHA256_ROUND(h, a, b, c, d, e, f, g,  9u, WORD); \
+                                                SHA256_ROUND(g, h, a, b, c, d, e, f, 10u, WORD); \
+                                                SHA256_ROUND(f, g, h, a, b, c, d, e, 11u, WORD); \
+                                                SHA256_ROUND(e, f, g, h, a, b, c, d, 12u, WORD); \
+                                                SHA256_ROUND(d, e, f, g, h, a, b, c, 13u, WORD); \
+                                                SHA256_ROUND(c, d, e, f, g, h, a, b, 14u, WORD); \
+                                                SHA256_ROUND(b, c, d, e, f, g, h, a, 15u, WORD)
+#define     SHA256_LOADED_WORD(i)               schedule[i]
+#define     SHA256_EXPANDED_WORD(i)             (schedule[i] = schedule[i] + SHA256_SMALL_SIGMA1(schedule[((i) + 14u) & 15u]) + \
+                                                               schedule[((i) + 9u) & 15u] + SHA256_SMALL_SIGMA0(schedule[((i) + 1u) & 15u]))
+
+/* The schedule is a 16-word window that rounds 16-63 overwrite as they go, W[t] replacing W[t - 16]. */
+static void SHA256_block_processor(const uint8_t* SHA256_block, uint32_t* SHA256_output)
+{
+    const uint32_t* round_constants = SHA256_constants;
+    uint32_t schedule[16u];
+    uint32_t round_temp;
+    uint32_t a = SHA256_output[0u];
+    uint32_t b = SHA256_output[1u];
+    uint32_t c = SHA256_output[2u];
+    uint32_t d = SHA256_output[3u];
+    uint32_t e = SHA256_output[4u];
+    uint32_t f = SHA256_output[5u];
+    uint32_t g = SHA256_output[6u];
+    uint32_t h = SHA256_output[7u];
+
+    for(size_t loop_var = 0u; loop_var < 16u; loop_var++)
+    {
+        schedule[loop_var] = LOAD_U32_BE(SHA256_block + (4u * loop_var));
+    }
+    SHA256_SIXTEEN_ROUNDS(SHA256_LOADED_WORD);
+    for(size_t loop_var = 1u; loop_var < 4u; loop_var++)
+    {
+        round_constants = round_constants + 16u;
+        SHA256_SIXTEEN_ROUNDS(SHA256_EXPANDED_WORD);
+    }
+
+    SHA256_output[0u] = SHA256_output[0u] + a;
+    SHA256_output[1u] = SHA256_output[1u] + b;
+    SHA256_output[2u] = SHA256_output[2u] + c;
+    SHA256_output[3u] = SHA256_output[3u] + d;
+    SHA256_output[4u] = SHA256_output[4u] + e;
+    SHA256_output[5u] = SHA256_output[5u] + f;
+    SHA256_output[6u] = SHA256_output[6u] + g;
+    SHA256_output[7u] = SHA256_output[7u] + h;
+}
+
+void SHA256_init(SHA256_context* context)
+{
+    SHA256_state_init(context->state);
+    context->length = 0u;
+    context->tail_bytes = 0u;
+}
+
+void SHA256_update(SHA256_context* context, const uint8_t* data, size_t length)
+{
+    context->length = context->length + length;
+    if(context->tail_bytes != 0u)
+    {
+        size_t needed = SHA256_BLOCK_BYTES - context->tail_bytes;
+        size_t taken = (length < needed) ? length : needed;
+
+        memcpy(context->tail + context->tail_bytes, data, taken);
+        context->tail_bytes = context->tail_bytes + taken;
+        data = data + taken;
+        length = length - taken;
+        if(context->tail_bytes < SHA256_BLOCK_BYTES)
+        {
+            return;
+        }
+        SHA256_block_processor(context->tail, context->state);
+        context->tail_bytes = 0u;
+    }
+    /* The stream is on a block boundary from here, so full blocks need no copy. */
+    for(; length >= SHA256_BLOCK_BYTES; length = length - SHA256_BLOCK_BYTES)
+    {
+        SHA256_block_processor(data, context->state);
+        data = data + SHA256_BLOCK_BYTES;
+    }
+    memcpy(context->tail, data, length);
+    context->tail_bytes = length;
+}
+
+void SHA256_final(SHA256_context* context, uint8_t* digest)
+{
+    uint64_t bit_length = context->length * 8u;
+    size_t read_bytes = context->tail_bytes;
+
+    context->tail[read_bytes++] = 0x80u;
+    /* No room left for the 8-byte length: pad this block out and put the length in one more. */
+    if(read_bytes > (SHA256_BLOCK_BYTES - 8u))
+    {
+        memset(context->tail + read_bytes, 0, SHA256_BLOCK_BYTES - read_bytes);
+        SHA256_block_processor(context->tail, context->state);
+        read_bytes = 0u;
+    }
+    memset(context->tail + read_bytes, 0, (SHA256_BLOCK_BYTES - 8u) - read_bytes);
+    for(size_t loop_var = 0u; loop_var < 8u; loop_var++)
+    {
+        context->tail[(SHA256_BLOCK_BYTES - 8u) + loop_var] = (uint8_t)(bit_length >> (8u * (7u - loop_var)));
+    }
+    SHA256_block_processor(context->tail, context->state);
+
+    for(size_t loop_var = 0u; loop_var < 8u; loop_var++)
+    {
+        STORE_U32_BE(digest + (4u * loop_var), context->state[loop_var]);
+    }
+    context->tail_bytes = 0u;
+}
+
+void SHA256_buffer(const uint8_t* data, size_t length, uint8_t* digest)
+{
+    SHA256_context context;
+
+    SHA256_init(&context);
+    SHA256_update(&context, data, length);
+    SHA256_final(&context, digest);
+}
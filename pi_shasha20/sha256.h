@@ -0,0 +1,29 @@
+#ifndef         _SHA256_H
+#define         _SHA256_H
+
+#include        <stddef.h>
+#include        <stdint.h>
+
+#define         SHA256_BLOCK_BYTES      64u
+#define         SHA256_DIGEST_BYTES     32u
+
+/* Streaming SHA-256. Updates may be any size: whole blocks are compressed straight from the caller's buffer and
+ * only the bytes of a block that straddles two updates are copied into tail. */
+typedef struct SHA256_context_s
+{
+    uint32_t state[8u];
+    uint64_t length;                        /* message bytes so far, so messages past 512 MiB pad correctly */
+    uint8_t tail[SHA256_BLOCK_BYTES];
+    size_t tail_bytes;
+} SHA256_context;
+
+void SHA256_init(SHA256_context* context);
+void SHA256_update(SHA256_context* context, const uint8_t* data, size_t length);
+
+/* Pads, writes the big-endian digest and leaves the context to be initialised again. */
+void SHA256_final(SHA256_context* context, uint8_t* digest);
+
+/* One-shot hash of a buffer in memory. */
+void SHA256_buffer(const uint8_t* data, size_t length, uint8_t* digest);
+
+#endif
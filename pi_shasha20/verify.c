@@ -0,0 +1,318 @@
+#include        <stdint.h>
+#include        <stdio.h>
+#include        <string.h>
+
+#include        "byte_order.h"
+#include        "chacha20.h"
+#include        "sha256.h"
+#include        "verify.h"
+
+#define         VERIFY_MILLION_CHUNK    1000u
+
+typedef struct SHA256_vector_s
+{
+    const char* message;
+    size_t repeats;             /* the message is hashed this many times over, back to back */
+    uint32_t digest[8u];
+} SHA256_vector;
+
+/* FIPS 180-2 appendix B, and the two-block message from the NIST example set. */
+static const SHA256_vector SHA256_vectors[] =
+{
+    { "abc", 1u, { 0xba7816bfu, 0x8f01cfeau, 0x414140deu, 0x5dae2223u, 0xb00361a3u, 0x96177a9cu, 0xb410ff61u, 0xf20015adu } },
+    { "", 1u, { 0xe3b0c442u, 0x98fc1c14u, 0x9afbf4c8u, 0x996fb924u, 0x27ae41e4u, 0x649b934cu, 0xa495991bu, 0x7852b855u } },
+    { "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", 1u,
+      { 0x248d6a61u, 0xd20638b8u, 0xe5c02693u, 0x0c3e6039u, 0xa33ce459u, 0x64ff2167u, 0xf6ecedd4u, 0x19db06c1u } },
+    { "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu", 1u,
+      { 0xcf5b16a7u, 0x78af8380u, 0x036ce59eu, 0x7b049237u, 0x0b249b11u, 0xe8f07a51u, 0xafac4503u, 0x7afee9d1u } },
+    { "a", 1000000u, { 0xcdc76e5cu, 0x9914fb92u, 0x81a1c7e2u, 0x84d73e67u, 0xf1809a48u, 0xa497200eu, 0x046d39ccu, 0xc7112cd0u } },
+};
+
+/* Update sizes every short vector is fed in, to cover straddling, exact and multi-block updates. */
+static const size_t SHA256_split_sizes[] = { 1u, 3u, 55u, 56u, 63u, 64u, 65u, 128u };
+
+static uint8_t verify_chunk[VERIFY_MILLION_CHUNK];
+
+#define         CHACHA20_VERIFY_BYTES   128u
+
+typedef struct chacha20_vector_s
+{
+    const char* name;
+    const uint8_t* key;
+    const uint8_t* nonce;
+    uint32_t counter;
+    const char* plaintext;      /* NULL for a keystream vector, whose plaintext is all zeroes */
+    const uint8_t* ciphertext;
+    size_t length;
+} chacha20_vector;
+
+/* RFC 8439 sections 2.3.2 and 2.4.2 and appendix A.1 #1 and A.2 #3. */
+static const uint8_t chacha20_sequential_key[CHACHA20_KEY_BYTES] =
+{
+    0x00u, 0x01u, 0x02u, 0x03u, 0x04u, 0x05u, 0x06u, 0x07u, 0x08u, 0x09u, 0x0au, 0x0bu, 0x0cu, 0x0du, 0x0eu, 0x0fu,
+    0x10u, 0x11u, 0x12u, 0x13u, 0x14u, 0x15u, 0x16u, 0x17u, 0x18u, 0x19u, 0x1au, 0x1bu, 0x1cu, 0x1du, 0x1eu, 0x1fu
+};
+
+static const uint8_t chacha20_zero_key[CHACHA20_KEY_BYTES];
+
+static const uint8_t chacha20_jabberwocky_key[CHACHA20_KEY_BYTES] =
+{
+    0x1cu, 0x92u, 0x40u, 0xa5u, 0xebu, 0x55u, 0xd3u, 0x8au, 0xf3u, 0x33u, 0x88u, 0x86u, 0x04u, 0xf6u, 0xb5u, 0xf0u,
+    0x47u, 0x39u, 0x17u, 0xc1u, 0x40u, 0x2bu, 0x80u, 0x09u, 0x9du, 0xcau, 0x5cu, 0xbcu, 0x20u, 0x70u, 0x75u, 0xc0u
+};
+
+static const uint8_t chacha20_block_nonce[CHACHA20_NONCE_BYTES] = { 0x00u, 0x00u, 0x00u, 0x09u, 0x00u, 0x00u, 0x00u, 0x4au, 0x00u, 0x00u, 0x00u, 0x00u };
+static const uint8_t chacha20_sunscreen_nonce[CHACHA20_NONCE_BYTES] = { 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x4au, 0x00u, 0x00u, 0x00u, 0x00u };
+static const uint8_t chacha20_zero_nonce[CHACHA20_NONCE_BYTES];
+static const uint8_t chacha20_jabberwocky_nonce[CHACHA20_NONCE_BYTES] = { 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x02u };
+
+static const uint8_t chacha20_block_keystream[64u] =
+{
+    0x10u, 0xf1u, 0xe7u, 0xe4u, 0xd1u, 0x3bu, 0x59u, 0x15u, 0x50u, 0x0fu, 0xddu, 0x1fu, 0xa3u, 0x20u, 0x71u, 0xc4u,
+    0xc7u, 0xd1u, 0xf4u, 0xc7u, 0x33u, 0xc0u, 0x68u, 0x03u, 0x04u, 0x22u, 0xaau, 0x9au, 0xc3u, 0xd4u, 0x6cu, 0x4eu,
+    0xd2u, 0x82u, 0x64u, 0x46u, 0x07u, 0x9fu, 0xaau, 0x09u, 0x14u, 0xc2u, 0xd7u, 0x05u, 0xd9u, 0x8bu, 0x02u, 0xa2u,
+    0xb5u, 0x12u, 0x9cu, 0xd1u, 0xdeu, 0x16u, 0x4eu, 0xb9u, 0xcbu, 0xd0u, 0x83u, 0xe8u, 0xa2u, 0x50u, 0x3cu, 0x4eu
+};
+
+static const uint8_t chacha20_zero_keystream[64u] =
+{
+    0x76u, 0xb8u, 0xe0u, 0xadu, 0xa0u, 0xf1u, 0x3du, 0x90u, 0x40u, 0x5du, 0x6au, 0xe5u, 0x53u, 0x86u, 0xbdu, 0x28u,
+    0xbdu, 0xd2u, 0x19u, 0xb8u, 0xa0u, 0x8du, 0xedu, 0x1au, 0xa8u, 0x36u, 0xefu, 0xccu, 0x8bu, 0x77u, 0x0du, 0xc7u,
+    0xdau, 0x41u, 0x59u, 0x7cu, 0x51u, 0x57u, 0x48u, 0x8du, 0x77u, 0x24u, 0xe0u, 0x3fu, 0xb8u, 0xd8u, 0x4au, 0x37u,
+    0x6au, 0x43u, 0xb8u, 0xf4u, 0x15u, 0x18u, 0xa1u, 0x1cu, 0xc3u, 0x87u, 0xb6u, 0x69u, 0xb2u, 0xeeu, 0x65u, 0x86u
+};
+
+static const uint8_t chacha20_sunscreen_ciphertext[114u] =
+{
+    0x6eu, 0x2eu, 0x35u, 0x9au, 0x25u, 0x68u, 0xf9u, 0x80u, 0x41u, 0xbau, 0x07u, 0x28u, 0xddu, 0x0du, 0x69u, 0x81u,
+    0xe9u, 0x7eu, 0x7au, 0xecu, 0x1du, 0x43u, 0x60u, 0xc2u, 0x0au, 0x27u, 0xafu, 0xccu, 0xfdu, 0x9fu, 0xaeu, 0x0bu,
+    0xf9u, 0x1bu, 0x65u, 0xc5u, 0x52u, 0x47u, 0x33u, 0xabu, 0x8fu, 0x59u, 0x3du, 0xabu, 0xcdu, 0x62u, 0xb3u, 0x57u,
+    0x16u, 0x39u, 0xd6u, 0x24u, 0xe6u, 0x51u, 0x52u, 0xabu, 0x8fu, 0x53u, 0x0cu, 0x35u, 0x9fu, 0x08u, 0x61u, 0xd8u,
+    0x07u, 0xcau, 0x0du, 0xbfu, 0x50u, 0x0du, 0x6au, 0x61u, 0x56u, 0xa3u, 0x8eu, 0x08u, 0x8au, 0x22u, 0xb6u, 0x5eu,
+    0x52u, 0xbcu, 0x51u, 0x4du, 0x16u, 0xccu, 0xf8u, 0x06u, 0x81u, 0x8cu, 0xe9u, 0x1au, 0xb7u, 0x79u, 0x37u, 0x36u,
+    0x5au, 0xf9u, 0x0bu, 0xbfu, 0x74u, 0xa3u, 0x5bu, 0xe6u, 0xb4u, 0x0bu, 0x8eu, 0xedu, 0xf2u, 0x78u, 0x5eu, 0x42u,
+    0x87u, 0x4du
+};
+
+static const uint8_t chacha20_jabberwocky_ciphertext[127u] =
+{
+    0x62u, 0xe6u, 0x34u, 0x7fu, 0x95u, 0xedu, 0x87u, 0xa4u, 0x5fu, 0xfau, 0xe7u, 0x42u, 0x6fu, 0x27u, 0xa1u, 0xdfu,
+    0x5fu, 0xb6u, 0x91u, 0x10u, 0x04u, 0x4cu, 0x0du, 0x73u, 0x11u, 0x8eu, 0xffu, 0xa9u, 0x5bu, 0x01u, 0xe5u, 0xcfu,
+    0x16u, 0x6du, 0x3du, 0xf2u, 0xd7u, 0x21u, 0xcau, 0xf9u, 0xb2u, 0x1eu, 0x5fu, 0xb1u, 0x4cu, 0x61u, 0x68u, 0x71u,
+    0xfdu, 0x84u, 0xc5u, 0x4fu, 0x9du, 0x65u, 0xb2u, 0x83u, 0x19u, 0x6cu, 0x7fu, 0xe4u, 0xf6u, 0x05u, 0x53u, 0xebu,
+    0xf3u, 0x9cu, 0x64u, 0x02u, 0xc4u, 0x22u, 0x34u, 0xe3u, 0x2au, 0x35u, 0x6bu, 0x3eu, 0x76u, 0x43u, 0x12u, 0xa6u,
+    0x1au, 0x55u, 0x32u, 0x05u, 0x57u, 0x16u, 0xeau, 0xd6u, 0x96u, 0x25u, 0x68u, 0xf8u, 0x7du, 0x3fu, 0x3fu, 0x77u,
+    0x04u, 0xc6u, 0xa8u, 0xd1u, 0xbcu, 0xd1u, 0xbfu, 0x4du, 0x50u, 0xd6u, 0x15u, 0x4bu, 0x6du, 0xa7u, 0x31u, 0xb1u,
+    0x87u, 0xb5u, 0x8du, 0xfdu, 0x72u, 0x8au, 0xfau, 0x36u, 0x75u, 0x7au, 0x79u, 0x7au, 0xc1u, 0x88u, 0xd1u
+};
+
+static const chacha20_vector chacha20_vectors[] =
+{
+    { "block function", chacha20_sequential_key, chacha20_block_nonce, 1u, NULL, chacha20_block_keystream, 64u },
+    { "zero key", chacha20_zero_key, chacha20_zero_nonce, 0u, NULL, chacha20_zero_keystream, 64u },
+    { "sunscreen", chacha20_sequential_key, chacha20_sunscreen_nonce, 1u,
+      "Ladies and Gentlemen of the class of '99: If I could offer you only one tip for the future, sunscreen would be it.",
+      chacha20_sunscreen_ciphertext, 114u },
+    { "jabberwocky", chacha20_jabberwocky_key, chacha20_jabberwocky_nonce, 42u,
+      "'Twas brillig, and the slithy toves\nDid gyre and gimble in the wabe:\nAll mimsy were the borogoves,\nAnd the mome raths outgrabe.",
+      chacha20_jabberwocky_ciphertext, 127u },
+};
+
+/* XOR sizes every vector is encrypted in; the odd ones reach the counter through chacha20_seek instead of init. */
+static const size_t chacha20_split_sizes[] = { 1u, 5u, 63u, 64u, 65u, 128u };
+
+static uint8_t chacha20_buffer[CHACHA20_VERIFY_BYTES];
+
+/* Index of the first digest word that differs, 8 when they all match. */
+static size_t first_bad_word(const uint8_t* digest, const uint32_t* expected)
+{
+    size_t loop_var = 0u;
+
+    while((loop_var < 8u) && (LOAD_U32_BE(digest + (4u * loop_var)) == expected[loop_var]))
+    {
+        loop_var = loop_var + 1u;
+    }
+    return loop_var;
+}
+
+/* Feeds the vector in updates of split bytes at most; repeated messages are built up a chunk at a time. */
+static void hash_vector(const SHA256_vector* vector, size_t split, uint8_t* digest)
+{
+    size_t length = strlen(vector->message);
+    const uint8_t* message = (const uint8_t*)vector->message;
+    SHA256_context context;
+
+    SHA256_init(&context);
+    if(vector->repeats > 1u)
+    {
+        size_t per_chunk = VERIFY_MILLION_CHUNK / length;
+
+        for(size_t loop_var = 0u; loop_var < per_chunk; loop_var++)
+        {
+            memcpy(verify_chunk + (loop_var * length), message, length);
+        }
+        message = verify_chunk;
+        for(size_t done = 0u; done < vector->repeats; done = done + per_chunk)
+        {
+            size_t count = ((vector->repeats - done) < per_chunk) ? (vector->repeats - done) : per_chunk;
+
+            SHA256_update(&context, message, count * length);
+        }
+    }
+    else
+    {
+        for(size_t offset = 0u; offset < length; offset = offset + split)
+        {
+            SHA256_update(&context, message + offset, ((length - offset) < split) ? (length - offset) : split);
+        }
+    }
+    SHA256_final(&context, digest);
+}
+
+size_t verify_sha256(int core_number)
+{
+    size_t vector_count = sizeof(SHA256_vectors) / sizeof(SHA256_vectors[0]);
+    size_t split_count = sizeof(SHA256_split_sizes) / sizeof(SHA256_split_sizes[0]);
+    size_t checks = 0u;
+    size_t errors = 0u;
+    uint8_t digest[SHA256_DIGEST_BYTES];
+
+    for(size_t vector = 0u; vector < vector_count; vector++)
+    {
+        const SHA256_vector* current = &SHA256_vectors[vector];
+        size_t splits = (current->repeats > 1u) ? 1u : split_count;
+
+        for(size_t split = 0u; split < splits; split++)
+        {
+            size_t bad_word;
+
+            hash_vector(current, SHA256_split_sizes[split], digest);
+            checks = checks + 1u;
+            bad_word = first_bad_word(digest, current->digest);
+            if(bad_word < 8u)
+            {
+                printf("[Core #%d] ERROR! SHA256 of \"%.16s\"%s x%zu in %zu-byte updates: word %zu is %08lx, should be %08lx.\n", core_number,
+                       current->message, (strlen(current->message) > 16u) ? "..." : "", current->repeats, SHA256_split_sizes[split], bad_word,
+                       (unsigned long)LOAD_U32_BE(digest + (4u * bad_word)), (unsigned long)current->digest[bad_word]);
+                errors = errors + 1u;
+            }
+        }
+    }
+    if(errors == 0u)
+    {
+        printf("[Core #%d] SHA256 known-answer tests: %zu of %zu pass.\n", core_number, checks, checks);
+    }
+    return errors;
+}
+
+static void load_plaintext(const chacha20_vector* vector)
+{
+    memset(chacha20_buffer, 0, sizeof(chacha20_buffer));
+    if(vector->plaintext != NULL)
+    {
+        memcpy(chacha20_buffer, vector->plaintext, vector->length);
+    }
+}
+
+/* Index of the first byte that differs, length when they all match. */
+static size_t first_bad_byte(const uint8_t* data, const uint8_t* expected, size_t length)
+{
+    size_t loop_var = 0u;
+
+    while((loop_var < length) && (data[loop_var] == expected[loop_var]))
+    {
+        loop_var = loop_var + 1u;
+    }
+    return loop_var;
+}
+
+size_t verify_chacha20(int core_number)
+{
+    size_t vector_count = sizeof(chacha20_vectors) / sizeof(chacha20_vectors[0]);
+    size_t split_count = sizeof(chacha20_split_sizes) / sizeof(chacha20_split_sizes[0]);
+    chacha20_context limit;
+    size_t checks = 0u;
+    size_t errors = 0u;
+
+    for(size_t vector = 0u; vector < vector_count; vector++)
+    {
+        const chacha20_vector* current = &chacha20_vectors[vector];
+        chacha20_context context;
+        size_t bad_byte;
+
+        for(size_t split = 0u; split < split_count; split++)
+        {
+            size_t split_bytes = chacha20_split_sizes[split];
+
+            load_plaintext(current);
+            chacha20_init(&context, current->key, current->nonce, (split & 1u) ? 0u : current->counter);
+            if(split & 1u)
+            {
+                chacha20_seek(&context, current->counter);
+            }
+            for(size_t offset = 0u; offset < current->length; offset = offset + split_bytes)
+            {
+                chacha20_xor(&context, chacha20_buffer + offset, ((current->length - offset) < split_bytes) ? (current->length - offset) : split_bytes);
+            }
+            checks = checks + 1u;
+            bad_byte = first_bad_byte(chacha20_buffer, current->ciphertext, current->length);
+            if(bad_byte < current->length)
+            {
+                printf("[Core #%d] ERROR! ChaCha20 %s in %zu-byte pieces: byte %zu is %02x, should be %02x.\n", core_number, current->name,
+                       split_bytes, bad_byte, chacha20_buffer[bad_byte], current->ciphertext[bad_byte]);
+                errors = errors + 1u;
+            }
+        }
+
+        /* Decrypting from the second block on by seeking straight to it must give back the rest of the plaintext. */
+        if((current->plaintext != NULL) && (current->length > CHACHA20_BLOCK_BYTES))
+        {
+            size_t tail = current->length - CHACHA20_BLOCK_BYTES;
+
+            memcpy(chacha20_buffer, current->ciphertext + CHACHA20_BLOCK_BYTES, tail);
+            chacha20_init(&context, current->key, current->nonce, 0u);
+            chacha20_seek(&context, current->counter + 1u);
+            chacha20_xor(&context, chacha20_buffer, tail);
+            checks = checks + 1u;
+            if(memcmp(chacha20_buffer, current->plaintext + CHACHA20_BLOCK_BYTES, tail) != 0)
+            {
+                printf("[Core #%d] ERROR! ChaCha20 %s: decrypting after a seek to block %lu does not give the plaintext back.\n", core_number,
+                       current->name, (unsigned long)(current->counter + 1u));
+                errors = errors + 1u;
+            }
+        }
+    }
+
+    /* Block 2^32 - 1 is the last one a nonce gets: using it must work, going past it in any call must not. */
+    memset(chacha20_buffer, 0, sizeof(chacha20_buffer));
+    chacha20_init(&limit, chacha20_zero_key, chacha20_zero_nonce, UINT32_MAX);
+    checks = checks + 1u;
+    if(!chacha20_xor(&limit, chacha20_buffer, CHACHA20_BLOCK_BYTES) || chacha20_xor(&limit, chacha20_buffer, 1u))
+    {
+        printf("[Core #%d] ERROR! ChaCha20 does not stop after the last block of the counter.\n", core_number);
+        errors = errors + 1u;
+    }
+    chacha20_seek(&limit, UINT32_MAX);
+    checks = checks + 1u;
+    if(chacha20_xor(&limit, chacha20_buffer, CHACHA20_BLOCK_BYTES + 1u))
+    {
+        printf("[Core #%d] ERROR! ChaCha20 runs past the last block of the counter within one call.\n", core_number);
+        errors = errors + 1u;
+    }
+    /* A seek starts the stream over, so block 0 of the zero key is usable again. */
+    memset(chacha20_buffer, 0, sizeof(chacha20_buffer));
+    chacha20_seek(&limit, 0u);
+    checks = checks + 1u;
+    if(!chacha20_xor(&limit, chacha20_buffer, CHACHA20_BLOCK_BYTES) ||
+       (memcmp(chacha20_buffer, chacha20_zero_keystream, CHACHA20_BLOCK_BYTES) != 0))
+    {
+        printf("[Core #%d] ERROR! ChaCha20 does not restart after a seek past the end of the counter.\n", core_number);
+        errors = errors + 1u;
+    }
+
+    if(errors == 0u)
+    {
+        printf("[Core #%d] ChaCha20 known-answer tests: %zu of %zu pass.\n", core_number, checks, checks);
+    }
+    return errors;
+}
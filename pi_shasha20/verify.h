@@ -0,0 +1,11 @@
+#ifndef         _VERIFY_H
+#define         _VERIFY_H
+
+#include        <stddef.h>
+
+/* Known-answer tests, run by the program itself so the host build checks them too. Each returns its number of
+ * failures and prints the ones it finds. */
+size_t verify_sha256(int core_number);
+size_t verify_chacha20(int core_number);
+
+#endif
@@ -21,6 +21,7 @@
 typedef int16_t MATDAT;
 typedef int32_t MATRES;
 typedef int32_t CORE_TICKS;
+typedef uintptr_t ee_ptr_int;
 
 typedef struct list_data_s
 {
@@ -89,7 +90,7 @@ typedef int32_t (*list_cmp)(list_data *a, list_data *b, core_results *res);
 #define matrix_big(x)            (0xf000 | (x))
 #define bit_extract(x, from, to) (((x) >> (from)) & (~(0xffffffff << (to))))
 #define get_seed(x) (int16_t) get_seed_32(x)
-#define align_mem(x) (void *)(4 + (((uint32_t)(x)-1) & ~3))
+#define align_mem(x) (void *)(4 + (((ee_ptr_int)(x)-1) & ~3))
 
 int16_t calc_func(int16_t *pdata, core_results *res);
 
@@ -944,7 +945,7 @@ check_data_types()
         printf("ERROR: uint32_t is not a 32b datatype!\n");
         retval++;
     }
-    if (sizeof(uint32_t) != sizeof(int*))
+    if (sizeof(ee_ptr_int) != sizeof(int*))
     {
         printf(
             "ERROR: ee_ptr_int is not a datatype that holds an int pointer!\n");